@@ -30,6 +30,7 @@ extern int bots_check_flag;
 extern int bots_result;
 extern int bots_output_format;
 extern int bots_print_header;
+extern int bots_counters_flag;
 /* common variables */
 extern char bots_name[];
 extern char bots_parameters[];
@@ -48,6 +49,19 @@ extern char bots_ldflags[];
 extern double bots_time_program;
 extern double bots_time_sequential;
 
+/* number of threads requested for the current run (0 = runtime default) */
+extern int bots_num_threads;
+
+/* repetition variables (bots_time_program holds the median of the samples) */
+extern int bots_repetitions;
+extern int bots_warmups;
+extern double *bots_time_samples;
+extern double bots_time_min;
+extern double bots_time_median;
+extern double bots_time_mean;
+extern double bots_time_stddev;
+extern double bots_time_p95;
+
 /* number of tasks variable */
 extern unsigned long long bots_number_of_tasks; /* forcing 8 bytes size on -m32 and -m64 */
 
@@ -63,9 +77,33 @@ extern int bots_arg_size_1;
 extern int bots_arg_size_2;
 
 /* function could be used in app. code but are implemented in bots_common.c */
+#ifdef __cplusplus
+extern "C" {
+#endif
 long bots_usecs();
+double bots_seconds(void);
+/* time a named phase (master thread only); reported next to Time Program */
+void bots_phase_begin(const char *name);
+void bots_phase_end(const char *name);
+/* places from OMP_PLACES and binding from OMP_PROC_BIND (see bots_topology.c) */
+int bots_get_num_places(void);
+int bots_get_num_nodes(void);
+int bots_get_place_node(int place);
+int bots_places_are_cores(void);
+int bots_get_node_id(int node);
+int bots_get_address_node(const void *addr);
+int bots_bind_to_node(int node);
+int bots_get_thread_place(int thread, int nthreads);
+int bots_bind_thread(int thread, int nthreads);
+/* runs init(arg, begin, end) over [0, n) on nthreads threads placed as the
+ * kernel threads, so each page is first touched near its user */
+typedef void (*bots_init_fn)(void *arg, long begin, long end);
+void bots_first_touch(long n, size_t size, int nthreads, bots_init_fn init, void *arg);
 void bots_error(int error, char *message);
 void bots_warning(int warning, char *message);
+#ifdef __cplusplus
+}
+#endif
 
 #define BOTS_RESULT_NA 0
 #define BOTS_RESULT_SUCCESSFUL 1
@@ -73,6 +111,11 @@ void bots_warning(int warning, char *message);
 #define BOTS_RESULT_NOT_REQUESTED 3
 
 
+typedef enum { BOTS_TIMER_MONOTONIC=0,
+               BOTS_TIMER_TSC } bots_timer_t;
+
+extern bots_timer_t bots_timer;
+
 typedef enum { BOTS_VERBOSE_NONE=0,
                BOTS_VERBOSE_DEFAULT,
                BOTS_VERBOSE_DEBUG } bots_verbose_mode_t;
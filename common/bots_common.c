@@ -18,14 +18,30 @@
 /*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA            */
 /**********************************************************************************************/
 
+#if defined (__linux)
+#define _GNU_SOURCE
+#include <sched.h>
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
 #include <time.h>
+#include <math.h>
 #include <sys/time.h>
 #include <sys/utsname.h>
 #include <sys/resource.h>
+#if defined (__linux)
+#include <errno.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define BOTS_HAVE_TSC
+#endif
 
 #include "bots_common.h"
 #include "bots_main.h"
@@ -75,11 +91,141 @@ bots_warning(int warning, char *message)
    else fprintf(stderr, "Warning (%d): %s\n",warning,message);
 }
 
+#ifdef CLOCK_MONOTONIC_RAW
+#define BOTS_CLOCK CLOCK_MONOTONIC_RAW
+#else
+#define BOTS_CLOCK CLOCK_MONOTONIC
+#endif
+
+static double bots_tsc_seconds_per_tick = 0.0;
+
+static double bots_monotonic_seconds (void)
+{
+   struct timespec t;
+   clock_gettime(BOTS_CLOCK, &t);
+   return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+#ifdef BOTS_HAVE_TSC
+static unsigned long long bots_tsc_ticks (void)
+{
+   unsigned int aux;
+   return __rdtscp(&aux);
+}
+
+static int bots_tsc_is_invariant (void)
+{
+   unsigned int eax, ebx, ecx, edx;
+   if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) return FALSE;
+   return (edx & (1 << 8)) != 0;
+}
+#endif
+
+/* Calibrates the TSC against the monotonic clock, falling back to the
+ * monotonic clock when there is no usable (invariant) TSC */
+void bots_timer_init (void)
+{
+   if (bots_timer != BOTS_TIMER_TSC) return;
+#ifdef BOTS_HAVE_TSC
+   if (bots_tsc_is_invariant()) {
+      double t0, t1;
+      unsigned long long c0, c1;
+
+      t0 = bots_monotonic_seconds();
+      c0 = bots_tsc_ticks();
+      do t1 = bots_monotonic_seconds(); while (t1 - t0 < 0.05);
+      c1 = bots_tsc_ticks();
+      bots_tsc_seconds_per_tick = (t1 - t0) / (double) (c1 - c0);
+      bots_debug("TSC calibrated at %.3f MHz\n", 1e-6 / bots_tsc_seconds_per_tick);
+      return;
+   }
+#endif
+   bots_warning(BOTS_WARNING, "No invariant TSC available, using the monotonic clock.");
+   bots_timer = BOTS_TIMER_MONOTONIC;
+}
+
+const char *bots_timer_name (void)
+{
+   switch (bots_timer)
+   {
+      case BOTS_TIMER_TSC:
+         return "tsc";
+      default:
+         return "monotonic";
+   }
+}
+
+double bots_seconds (void)
+{
+#ifdef BOTS_HAVE_TSC
+   if (bots_timer == BOTS_TIMER_TSC) return bots_tsc_ticks() * bots_tsc_seconds_per_tick;
+#endif
+   return bots_monotonic_seconds();
+}
+
 long bots_usecs (void)
 {
-   struct timeval t;
-   gettimeofday(&t,NULL);
-   return t.tv_sec*1000000+t.tv_usec;
+   struct timespec t;
+   clock_gettime(BOTS_CLOCK, &t);
+   return t.tv_sec*1000000+t.tv_nsec/1000;
+}
+
+/* Phases are named intervals timed by the master thread; the time of
+ * every begin/end pair with the same name is accumulated */
+bots_phase_t bots_phases[BOTS_MAX_PHASES];
+int bots_number_of_phases = 0;
+
+static bots_phase_t *bots_phase_lookup(const char *name, int create)
+{
+   int i;
+
+   for (i = 0; i < bots_number_of_phases; i++)
+      if (strcmp(bots_phases[i].name, name) == 0) return &bots_phases[i];
+
+   if (!create) return NULL;
+   if (bots_number_of_phases == BOTS_MAX_PHASES) {
+      bots_warning(BOTS_WARNING, "Too many phases, phase ignored.");
+      return NULL;
+   }
+   i = bots_number_of_phases++;
+   snprintf(bots_phases[i].name, BOTS_PHASE_NAME_SZ, "%s", name);
+   bots_phases[i].total = 0.0;
+   bots_phases[i].calls = 0;
+   bots_phases[i].running = FALSE;
+   return &bots_phases[i];
+}
+
+void bots_phase_begin(const char *name)
+{
+   bots_phase_t *phase = bots_phase_lookup(name, TRUE);
+
+   if (phase == NULL) return;
+   phase->running = TRUE;
+   phase->start = bots_seconds();
+}
+
+void bots_phase_end(const char *name)
+{
+   double end = bots_seconds();
+   bots_phase_t *phase = bots_phase_lookup(name, FALSE);
+
+   if (phase == NULL || !phase->running) {
+      bots_warning(BOTS_WARNING, "Ending a phase that was not started.");
+      return;
+   }
+   phase->total += end - phase->start;
+   phase->calls++;
+   phase->running = FALSE;
+}
+
+void bots_phases_reset(void)
+{
+   int i;
+
+   for (i = 0; i < bots_number_of_phases; i++) {
+      bots_phases[i].total = 0.0;
+      bots_phases[i].calls = 0;
+   }
 }
 
 void
@@ -112,18 +258,411 @@ void bots_get_load_average(char *str)
 void bots_get_load_average(char *str) { sprintf(str,";;"); }
 #endif
 
+#if defined (__linux)
+/* ****************************************************************** */
+void bots_get_cpu_model(char *str)
+{
+   char line[BOTS_TMP_STR_SZ];
+   char *value;
+   FILE *cpuinfo = fopen("/proc/cpuinfo", "r");
+
+   sprintf(str, "unknown");
+   if (cpuinfo == NULL) return;
+   while (fgets(line, BOTS_TMP_STR_SZ, cpuinfo) != NULL) {
+      if (strncmp(line, "model name", 10) != 0 || (value = strchr(line, ':')) == NULL) continue;
+      value += strspn(value, ": \t");
+      value[strcspn(value, "\n")] = '\0';
+      snprintf(str, BOTS_TMP_STR_SZ, "%s", value);
+      break;
+   }
+   fclose(cpuinfo);
+}
+
+/* ****************************************************************** */
+void bots_get_affinity(char *str)
+{
+   cpu_set_t mask;
+   int cpu, first, len = 0;
+
+   str[0] = '\0';
+   if (sched_getaffinity(0, sizeof(mask), &mask) != 0) return;
+   /* print as a list of ranges, e.g. 0-3,8-11 */
+   for (cpu = 0; cpu < CPU_SETSIZE && len < BOTS_TMP_STR_SZ; cpu++) {
+      if (!CPU_ISSET(cpu, &mask)) continue;
+      first = cpu;
+      while (cpu + 1 < CPU_SETSIZE && CPU_ISSET(cpu + 1, &mask)) cpu++;
+      if (first == cpu) len += snprintf(str + len, BOTS_TMP_STR_SZ - len, "%s%d", len ? "," : "", cpu);
+      else len += snprintf(str + len, BOTS_TMP_STR_SZ - len, "%s%d-%d", len ? "," : "", first, cpu);
+   }
+}
+#else
+/* ****************************************************************** */
+void bots_get_cpu_model(char *str) { sprintf(str,"unknown"); }
+void bots_get_affinity(char *str) { str[0] = '\0'; }
+#endif
+
+static int
+bots_compare_doubles(const void *a, const void *b)
+{
+   double x = *(const double *) a;
+   double y = *(const double *) b;
+   return (x > y) - (x < y);
+}
+
+void
+bots_compute_time_statistics(double *samples, int n)
+{
+   double *sorted, sum = 0.0, sq = 0.0;
+   int i, p95;
+
+   sorted = (double *) malloc(n * sizeof(double));
+   if (sorted == NULL) bots_error(BOTS_ERROR_NOT_ENOUGH_MEMORY, NULL);
+   memcpy(sorted, samples, n * sizeof(double));
+   qsort(sorted, n, sizeof(double), bots_compare_doubles);
+
+   for (i = 0; i < n; i++) sum += sorted[i];
+   bots_time_mean = sum / n;
+   for (i = 0; i < n; i++) sq += (sorted[i] - bots_time_mean) * (sorted[i] - bots_time_mean);
+   bots_time_stddev = (n > 1) ? sqrt(sq / (n - 1)) : 0.0;
+
+   bots_time_min = sorted[0];
+   if (n % 2) bots_time_median = sorted[n/2];
+   else bots_time_median = (sorted[n/2-1] + sorted[n/2]) / 2;
+
+   /* nearest-rank percentile */
+   p95 = (int) ceil(0.95 * n) - 1;
+   bots_time_p95 = sorted[p95 < 0 ? 0 : p95];
+
+   free(sorted);
+}
+
+/* Hardware performance counters. Events are opened with inherit set
+ * before any thread is created, so they also count all the threads the
+ * runtime spawns later, and are only enabled around KERNEL_CALL. Events
+ * the system can not provide are reported as n/a. */
+#define BOTS_COUNTER_NA (-1.0)
+
+typedef struct {
+   const char *name;
+   const char *column;
+   const char *key;
+   unsigned int type;
+   unsigned long long config;
+   int fd;
+   double value;
+} bots_counter_t;
+
+#if defined (__linux)
+#define BOTS_HW_CACHE_MISS(cache) \
+   ((cache) | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+static bots_counter_t bots_counters[] = {
+   { "Cycles",           "Cycles",       "cycles",           PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES,       -1, BOTS_COUNTER_NA },
+   { "Instructions",     "Instructions", "instructions",     PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS,     -1, BOTS_COUNTER_NA },
+   { "LLC Misses",       "LLC Misses",   "llc_misses",       PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES,     -1, BOTS_COUNTER_NA },
+   { "Branch Misses",    "Branch Misses","branch_misses",    PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES,    -1, BOTS_COUNTER_NA },
+   { "dTLB Misses",      "dTLB Misses",  "dtlb_misses",      PERF_TYPE_HW_CACHE, BOTS_HW_CACHE_MISS(PERF_COUNT_HW_CACHE_DTLB), -1, BOTS_COUNTER_NA },
+   { "Context Switches", "Ctx Switches", "context_switches", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, -1, BOTS_COUNTER_NA },
+};
+#define BOTS_NUMBER_OF_COUNTERS ((int) (sizeof(bots_counters)/sizeof(bots_counters[0])))
+
+static int bots_counter_open(bots_counter_t *counter, int group_fd)
+{
+   struct perf_event_attr attr;
+   int fd;
+
+   memset(&attr, 0, sizeof(attr));
+   attr.size = sizeof(attr);
+   attr.type = counter->type;
+   attr.config = counter->config;
+   attr.disabled = (group_fd == -1);
+   attr.inherit = 1;
+   attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+   fd = syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0);
+   if (fd == -1 && (errno == EACCES || errno == EPERM)) {
+      /* unprivileged users may still count user space */
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      fd = syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0);
+   }
+   return fd;
+}
+
+void bots_counters_init(void)
+{
+   int i, leader = -1, opened = 0;
+
+   if (!bots_counters_flag) return;
+
+   for (i = 0; i < BOTS_NUMBER_OF_COUNTERS; i++) {
+      bots_counter_t *counter = &bots_counters[i];
+
+      /* try to join the group so events are scheduled together */
+      counter->fd = bots_counter_open(counter, leader);
+      if (counter->fd == -1 && leader != -1) counter->fd = bots_counter_open(counter, -1);
+      if (counter->fd == -1) {
+         bots_debug("Counter %s is not available: %s\n", counter->name, strerror(errno));
+         continue;
+      }
+      if (leader == -1) leader = counter->fd;
+      counter->value = 0.0;
+      opened++;
+   }
+   if (opened == 0) {
+      bots_warning(BOTS_WARNING, "No performance counters available (check perf_event_paranoid).");
+      bots_counters_flag = FALSE;
+   }
+}
+
+static void bots_counters_ioctl(unsigned long request)
+{
+   int i;
+
+   for (i = 0; i < BOTS_NUMBER_OF_COUNTERS; i++)
+      if (bots_counters[i].fd != -1) ioctl(bots_counters[i].fd, request, 0);
+}
+
+void bots_counters_start(void)
+{
+   if (bots_counters_flag) bots_counters_ioctl(PERF_EVENT_IOC_ENABLE);
+}
+
+void bots_counters_reset(void)
+{
+   if (bots_counters_flag) bots_counters_ioctl(PERF_EVENT_IOC_RESET);
+}
+
+void bots_counters_stop(void)
+{
+   int i;
+   unsigned long long buf[3];
+
+   if (!bots_counters_flag) return;
+   bots_counters_ioctl(PERF_EVENT_IOC_DISABLE);
+
+   /* counters keep accumulating across repetitions, read the totals */
+   for (i = 0; i < BOTS_NUMBER_OF_COUNTERS; i++) {
+      bots_counter_t *counter = &bots_counters[i];
+
+      if (counter->fd == -1) continue;
+      if (read(counter->fd, buf, sizeof(buf)) != sizeof(buf) || buf[2] == 0) {
+         counter->value = BOTS_COUNTER_NA;
+         continue;
+      }
+      /* scale when the events were multiplexed */
+      counter->value = (double) buf[0] * ((double) buf[1] / (double) buf[2]);
+   }
+}
+#else
+static bots_counter_t bots_counters[1];
+#define BOTS_NUMBER_OF_COUNTERS 0
+
+void bots_counters_init(void)
+{
+   if (bots_counters_flag) {
+      bots_warning(BOTS_WARNING, "Performance counters are only supported on Linux.");
+      bots_counters_flag = FALSE;
+   }
+}
+void bots_counters_start(void) { }
+void bots_counters_stop(void) { }
+void bots_counters_reset(void) { }
+#endif
+
+/* Machine-readable output. Both formats share the same fields, in the
+ * same order; CSV packs the samples and phases into one field each. */
+#define BOTS_SCHEMA_VERSION 1
+
+static void bots_print_json_string(const char *str)
+{
+   fputc('"', stdout);
+   for (; *str; str++) {
+      if (*str == '"' || *str == '\\') fprintf(stdout, "\\%c", *str);
+      else if ((unsigned char) *str < 0x20) fprintf(stdout, "\\u%04x", *str);
+      else fputc(*str, stdout);
+   }
+   fputc('"', stdout);
+}
+
+static void bots_print_csv_string(const char *str)
+{
+   fputc('"', stdout);
+   for (; *str; str++) {
+      if (*str == '"') fputc('"', stdout);
+      fputc(*str, stdout);
+   }
+   fputc('"', stdout);
+}
+
+static const char *bots_result_name(void)
+{
+   switch(bots_result)
+   {
+      case BOTS_RESULT_NA: return "n/a";
+      case BOTS_RESULT_SUCCESSFUL: return "successful";
+      case BOTS_RESULT_UNSUCCESSFUL: return "unsuccessful";
+      case BOTS_RESULT_NOT_REQUESTED: return "not requested";
+      default: return "error";
+   }
+}
+
+static void bots_print_csv_header(void)
+{
+   int i;
+
+   fprintf(stdout, "schema,benchmark,parameters,model,cutoff,threads,affinity,cpu_model,architecture,"
+                   "result,time_program,time_sequential,speedup,tasks,tasks_per_second,"
+                   "repetitions,warmups,time_min,time_median,time_mean,time_stddev,time_p95,samples,"
+                   "timer,phases");
+   for (i = 0; i < BOTS_NUMBER_OF_COUNTERS; i++) fprintf(stdout, ",%s", bots_counters[i].key);
+   fprintf(stdout, ",ipc,exec_date,exec_message,load_avg,comp_date,comp_message,cc,cflags,ld,ldflags\n");
+}
+
+/* prints a number, or the empty value of the format when not available */
+static void bots_print_value(int json, int available, const char *fmt, double value)
+{
+   if (available) fprintf(stdout, fmt, value);
+   else if (json) fprintf(stdout, "null");
+}
+
+static void bots_print_structured(int json)
+{
+   char str_affinity[BOTS_TMP_STR_SZ];
+   char str_cpu_model[BOTS_TMP_STR_SZ];
+   char str_architecture[BOTS_TMP_STR_SZ];
+   char str_load_avg[BOTS_TMP_STR_SZ];
+   int i, first = TRUE;
+
+   /* every field is preceded by a comma except the first one */
+#define BOTS_FIELD(key) \
+   { if (!first) fputc(',', stdout); if (json) fprintf(stdout, "\"" key "\":"); first = FALSE; }
+#define BOTS_STRING(key, str) \
+   { BOTS_FIELD(key); if (json) bots_print_json_string(str); else bots_print_csv_string(str); }
+#define BOTS_NUMBER(key, available, fmt, value) \
+   { BOTS_FIELD(key); bots_print_value(json, available, fmt, value); }
+
+   bots_get_affinity(str_affinity);
+   bots_get_cpu_model(str_cpu_model);
+   bots_get_architecture(str_architecture);
+   bots_get_load_average(str_load_avg);
+
+   if (json) fputc('{', stdout);
+   BOTS_NUMBER("schema", TRUE, "%.0f", (double) BOTS_SCHEMA_VERSION);
+   BOTS_STRING("benchmark", bots_name);
+   BOTS_STRING("parameters", bots_parameters);
+   BOTS_STRING("model", bots_model);
+   BOTS_STRING("cutoff", bots_cutoff);
+   BOTS_NUMBER("threads", TRUE, "%.0f", (double) atoi(bots_resources));
+   BOTS_STRING("affinity", str_affinity);
+   BOTS_STRING("cpu_model", str_cpu_model);
+   BOTS_STRING("architecture", str_architecture);
+   BOTS_STRING("result", bots_result_name());
+   BOTS_NUMBER("time_program", TRUE, "%.9f", bots_time_program);
+   BOTS_NUMBER("time_sequential", bots_sequential_flag, "%.9f", bots_time_sequential);
+   /* a time of 0 (tiny inputs, coarse timer) has no rate: null, not inf */
+   BOTS_NUMBER("speedup", bots_sequential_flag && bots_time_program > 0, "%.4f",
+               bots_time_program > 0 ? bots_time_sequential/bots_time_program : 0.0);
+   BOTS_NUMBER("tasks", TRUE, "%.0f", (double) bots_number_of_tasks);
+   BOTS_NUMBER("tasks_per_second", bots_time_program > 0, "%.2f",
+               bots_time_program > 0 ? (double) bots_number_of_tasks/bots_time_program : 0.0);
+   BOTS_NUMBER("repetitions", TRUE, "%.0f", (double) bots_repetitions);
+   BOTS_NUMBER("warmups", TRUE, "%.0f", (double) bots_warmups);
+   BOTS_NUMBER("time_min", TRUE, "%.9f", bots_time_min);
+   BOTS_NUMBER("time_median", TRUE, "%.9f", bots_time_median);
+   BOTS_NUMBER("time_mean", TRUE, "%.9f", bots_time_mean);
+   BOTS_NUMBER("time_stddev", TRUE, "%.9f", bots_time_stddev);
+   BOTS_NUMBER("time_p95", TRUE, "%.9f", bots_time_p95);
+
+   BOTS_FIELD("samples");
+   fputs(json ? "[" : "\"", stdout);
+   for (i = 0; i < bots_repetitions; i++)
+      fprintf(stdout, "%s%.9f", i ? (json ? "," : "|") : "", bots_time_samples[i]);
+   fputs(json ? "]" : "\"", stdout);
+
+   BOTS_STRING("timer", bots_timer_name());
+
+   BOTS_FIELD("phases");
+   fputs(json ? "{" : "\"", stdout);
+   for (i = 0; i < bots_number_of_phases; i++) {
+      if (json) {
+         fputs(i ? "," : "", stdout);
+         bots_print_json_string(bots_phases[i].name);
+         fprintf(stdout, ":%.9f", bots_phases[i].total);
+      }
+      else fprintf(stdout, "%s%s=%.9f", i ? "|" : "", bots_phases[i].name, bots_phases[i].total);
+   }
+   fputs(json ? "}" : "\"", stdout);
+
+   if (json) fprintf(stdout, ",\"counters\":{");
+   for (i = 0; i < BOTS_NUMBER_OF_COUNTERS; i++) {
+      int available = bots_counters_flag && bots_counters[i].value != BOTS_COUNTER_NA;
+      if (json) fprintf(stdout, "%s\"%s\":", i ? "," : "", bots_counters[i].key);
+      else fputc(',', stdout);
+      bots_print_value(json, available, "%.0f", bots_counters[i].value / bots_repetitions);
+   }
+   if (json) fputc('}', stdout);
+   BOTS_NUMBER("ipc", bots_counters_flag && BOTS_NUMBER_OF_COUNTERS >= 2 && bots_counters[0].value > 0
+                      && bots_counters[1].value != BOTS_COUNTER_NA,
+               "%.4f", BOTS_NUMBER_OF_COUNTERS >= 2 ? bots_counters[1].value / bots_counters[0].value : 0.0);
+
+   BOTS_STRING("exec_date", bots_exec_date);
+   BOTS_STRING("exec_message", bots_exec_message);
+   BOTS_STRING("load_avg", str_load_avg);
+   BOTS_STRING("comp_date", bots_comp_date);
+   BOTS_STRING("comp_message", bots_comp_message);
+   BOTS_STRING("cc", bots_cc);
+   BOTS_STRING("cflags", bots_cflags);
+   BOTS_STRING("ld", bots_ld);
+   BOTS_STRING("ldflags", bots_ldflags);
+   if (json) fputc('}', stdout);
+   fputc('\n', stdout);
+   fflush(stdout);
+
+#undef BOTS_NUMBER
+#undef BOTS_STRING
+#undef BOTS_FIELD
+}
+
+/* Speed-up and efficiency are relative to the first point of the sweep */
+void bots_print_sweep(int n, int *threads, double *times)
+{
+   int i;
+   double speed_up;
+
+   if (bots_output_format < 1 || bots_output_format > 4) return;
+
+   fprintf(stdout, "\n");
+   fprintf(stdout, "Scalability sweep (relative to %d threads)\n", threads[0]);
+   fprintf(stdout, "%10s %16s %10s %10s\n", "Threads", "Time (s)", "Speed-up", "Efficiency");
+   for (i = 0; i < n; i++) {
+      speed_up = times[0] / times[i];
+      fprintf(stdout, "%10d %16f %10.2f %9.1f%%\n", threads[i], times[i], speed_up,
+              100.0 * speed_up * threads[0] / threads[i]);
+   }
+   fflush(stdout);
+}
+
 void bots_print_results()
 {
    char str_name[BOTS_TMP_STR_SZ];
    char str_parameters[BOTS_TMP_STR_SZ];
    char str_model[BOTS_TMP_STR_SZ];
    char str_resources[BOTS_TMP_STR_SZ];
-   char str_result[15];
-   char str_time_program[15];
-   char str_time_sequential[15];
-   char str_speed_up[15];
-   char str_number_of_tasks[15];
-   char str_number_of_tasks_per_second[15];
+   char str_result[BOTS_TMP_STR_SZ];
+   char str_time_program[BOTS_TMP_STR_SZ];
+   char str_time_sequential[BOTS_TMP_STR_SZ];
+   char str_speed_up[BOTS_TMP_STR_SZ];
+   char str_number_of_tasks[BOTS_TMP_STR_SZ];
+   char str_number_of_tasks_per_second[BOTS_TMP_STR_SZ];
+   char str_task_granularity[BOTS_TMP_STR_SZ];
+   char str_repetitions[BOTS_TMP_STR_SZ];
+   char str_warmups[BOTS_TMP_STR_SZ];
+   char str_time_min[BOTS_TMP_STR_SZ];
+   char str_time_median[BOTS_TMP_STR_SZ];
+   char str_time_mean[BOTS_TMP_STR_SZ];
+   char str_time_stddev[BOTS_TMP_STR_SZ];
+   char str_time_p95[BOTS_TMP_STR_SZ];
    char str_exec_date[BOTS_TMP_STR_SZ];
    char str_exec_message[BOTS_TMP_STR_SZ];
    char str_architecture[BOTS_TMP_STR_SZ];
@@ -135,6 +674,11 @@ void bots_print_results()
    char str_ld[BOTS_TMP_STR_SZ];
    char str_ldflags[BOTS_TMP_STR_SZ];
    char str_cutoff[BOTS_TMP_STR_SZ];
+   char str_timer[BOTS_TMP_STR_SZ];
+   char str_phases[BOTS_MAX_PHASES][BOTS_TMP_STR_SZ];
+   char str_counters[BOTS_NUMBER_OF_COUNTERS+1][32];
+   char str_ipc[BOTS_TMP_STR_SZ];
+   int i;
 
    /* compute output strings */
    sprintf(str_name, "%s", bots_name);
@@ -169,6 +713,16 @@ void bots_print_results()
 
    sprintf(str_number_of_tasks, "%3.2f", (float) bots_number_of_tasks);
    sprintf(str_number_of_tasks_per_second, "%3.2f", (float) bots_number_of_tasks/bots_time_program);
+   /* average time a thread spends per task */
+   sprintf(str_task_granularity, "%3.2f", bots_time_program * atoi(bots_resources) * 1e6 / bots_number_of_tasks);
+
+   sprintf(str_repetitions, "%d", bots_repetitions);
+   sprintf(str_warmups, "%d", bots_warmups);
+   sprintf(str_time_min, "%f", bots_time_min);
+   sprintf(str_time_median, "%f", bots_time_median);
+   sprintf(str_time_mean, "%f", bots_time_mean);
+   sprintf(str_time_stddev, "%f", bots_time_stddev);
+   sprintf(str_time_p95, "%f", bots_time_p95);
 
    sprintf(str_exec_date, "%s", bots_exec_date);
    sprintf(str_exec_message, "%s", bots_exec_message);
@@ -180,6 +734,17 @@ void bots_print_results()
    sprintf(str_cflags, "%s", bots_cflags);
    sprintf(str_ld, "%s", bots_ld);
    sprintf(str_ldflags, "%s", bots_ldflags);
+   sprintf(str_timer, "%s", bots_timer_name());
+   for (i = 0; i < bots_number_of_phases; i++)
+      sprintf(str_phases[i], "%f", bots_phases[i].total);
+   /* counters are reported per timed repetition */
+   for (i = 0; i < BOTS_NUMBER_OF_COUNTERS; i++) {
+      if (bots_counters[i].value == BOTS_COUNTER_NA) sprintf(str_counters[i], "n/a");
+      else sprintf(str_counters[i], "%.0f", bots_counters[i].value / bots_repetitions);
+   }
+   if (BOTS_NUMBER_OF_COUNTERS >= 2 && bots_counters[0].value > 0 && bots_counters[1].value != BOTS_COUNTER_NA)
+      sprintf(str_ipc, "%3.2f", bots_counters[1].value / bots_counters[0].value);
+   else sprintf(str_ipc, "n/a");
 
    if(bots_print_header)
    {
@@ -196,7 +761,16 @@ Time;Sequential;Speed-up;\
 Nodes;Nodes/Sec;\
 Exec Date;Exec Time;Exec Message;\
 Architecture;Processors;Load Avg-1;Load Avg-5;Load Avg-15;\
-Comp Date;Comp Time;Comp Message;CC;CFLAGS;LD;LDFLAGS\n");
+Comp Date;Comp Time;Comp Message;CC;CFLAGS;LD;LDFLAGS;\
+Timer;Repetitions;Warm-up;Time Min;Time Median;Time Mean;Time Stddev;Time P95");
+            for (i = 0; i < bots_number_of_phases; i++)
+               fprintf(stdout, ";Time %s", bots_phases[i].name);
+            if (bots_counters_flag) {
+               for (i = 0; i < BOTS_NUMBER_OF_COUNTERS; i++)
+                  fprintf(stdout, ";%s", bots_counters[i].column);
+               fprintf(stdout, ";IPC");
+            }
+            fprintf(stdout, "\n");
             break;
          case 3:
             break;
@@ -204,7 +778,21 @@ Comp Date;Comp Time;Comp Message;CC;CFLAGS;LD;LDFLAGS\n");
 fprintf(stdout,
 "Benchmark;Parameters;Model;Cutoff;Resources;Result;\
 Time;Sequential;Speed-up;\
-Nodes;Nodes/Sec;\n");
+Nodes;Nodes/Sec;\
+Repetitions;Warm-up;Time Min;Time Median;Time Mean;Time Stddev;Time P95");
+            for (i = 0; i < bots_number_of_phases; i++)
+               fprintf(stdout, ";Time %s", bots_phases[i].name);
+            if (bots_counters_flag) {
+               for (i = 0; i < BOTS_NUMBER_OF_COUNTERS; i++)
+                  fprintf(stdout, ";%s", bots_counters[i].column);
+               fprintf(stdout, ";IPC");
+            }
+            fprintf(stdout, "\n");
+            break;
+         case 5:
+            break;
+         case 6:
+            bots_print_csv_header();
             break;
          default:
             break;
@@ -234,8 +822,28 @@ Nodes;Nodes/Sec;\n");
          if ( bots_number_of_tasks > 0 ) {
            fprintf(stdout, "Nodes               = %s\n", str_number_of_tasks);
            fprintf(stdout, "Nodes/Sec           = %s\n", str_number_of_tasks_per_second);
+           fprintf(stdout, "Task Granularity    = %s us\n", str_task_granularity);
 	 }
 
+         if ( bots_repetitions > 1 ) {
+           fprintf(stdout, "Repetitions         = %s (+%s warm-up)\n", str_repetitions, str_warmups);
+           fprintf(stdout, "Time Min            = %s seconds\n", str_time_min);
+           fprintf(stdout, "Time Median         = %s seconds\n", str_time_median);
+           fprintf(stdout, "Time Mean           = %s seconds\n", str_time_mean);
+           fprintf(stdout, "Time Std. Dev.      = %s seconds\n", str_time_stddev);
+           fprintf(stdout, "Time P95            = %s seconds\n", str_time_p95);
+	 }
+
+         for (i = 0; i < bots_number_of_phases; i++)
+           fprintf(stdout, "Time %-14s = %s seconds (%d calls)\n",
+                bots_phases[i].name, str_phases[i], bots_phases[i].calls);
+
+         if (bots_counters_flag) {
+           for (i = 0; i < BOTS_NUMBER_OF_COUNTERS; i++)
+             fprintf(stdout, "%-19s = %s\n", bots_counters[i].name, str_counters[i]);
+           fprintf(stdout, "IPC                 = %s\n", str_ipc);
+         }
+
          fprintf(stdout, "Execution Date      = %s\n", str_exec_date);
          fprintf(stdout, "Execution Message   = %s\n", str_exec_message);
 
@@ -249,6 +857,7 @@ Nodes;Nodes/Sec;\n");
          fprintf(stdout, "Compiler Flags      = %s\n", str_cflags);
          fprintf(stdout, "Linker              = %s\n", str_ld);
          fprintf(stdout, "Linker Flags        = %s\n", str_ldflags);
+         fprintf(stdout, "Timer               = %s\n", str_timer);
 	 fflush(stdout);
          break;
       case 2:
@@ -287,6 +896,23 @@ Nodes;Nodes/Sec;\n");
               str_ld,
               str_ldflags
          );
+         fprintf(stdout,"%s;", str_timer);
+         fprintf(stdout,"%s;%s;%s;%s;%s;%s;%s;",
+              str_repetitions,
+              str_warmups,
+              str_time_min,
+              str_time_median,
+              str_time_mean,
+              str_time_stddev,
+              str_time_p95
+         );
+         for (i = 0; i < bots_number_of_phases; i++)
+            fprintf(stdout,"%s;", str_phases[i]);
+         if (bots_counters_flag) {
+            for (i = 0; i < BOTS_NUMBER_OF_COUNTERS; i++)
+               fprintf(stdout,"%s;", str_counters[i]);
+            fprintf(stdout,"%s;", str_ipc);
+         }
          fprintf(stdout,"\n");
          break;
       case 3:
@@ -307,7 +933,27 @@ Nodes;Nodes/Sec;\n");
          if ( bots_number_of_tasks > 0 ) {
            fprintf(stdout, "Nodes               = %s\n", str_number_of_tasks);
            fprintf(stdout, "Nodes/Sec           = %s\n", str_number_of_tasks_per_second);
+           fprintf(stdout, "Task Granularity    = %s us\n", str_task_granularity);
+	 }
+
+         if ( bots_repetitions > 1 ) {
+           fprintf(stdout, "Repetitions         = %s (+%s warm-up)\n", str_repetitions, str_warmups);
+           fprintf(stdout, "Time Min            = %s seconds\n", str_time_min);
+           fprintf(stdout, "Time Median         = %s seconds\n", str_time_median);
+           fprintf(stdout, "Time Mean           = %s seconds\n", str_time_mean);
+           fprintf(stdout, "Time Std. Dev.      = %s seconds\n", str_time_stddev);
+           fprintf(stdout, "Time P95            = %s seconds\n", str_time_p95);
 	 }
+
+         for (i = 0; i < bots_number_of_phases; i++)
+           fprintf(stdout, "Time %-14s = %s seconds (%d calls)\n",
+                bots_phases[i].name, str_phases[i], bots_phases[i].calls);
+
+         if (bots_counters_flag) {
+           for (i = 0; i < BOTS_NUMBER_OF_COUNTERS; i++)
+             fprintf(stdout, "%-19s = %s\n", bots_counters[i].name, str_counters[i]);
+           fprintf(stdout, "IPC                 = %s\n", str_ipc);
+         }
          break;
       case 4:
          fprintf(stdout,"%s;%s;%s;%s;%s;%s;", 
@@ -327,8 +973,30 @@ Nodes;Nodes/Sec;\n");
               str_number_of_tasks, 
               str_number_of_tasks_per_second
          );
+         fprintf(stdout,"%s;%s;%s;%s;%s;%s;%s;",
+              str_repetitions,
+              str_warmups,
+              str_time_min,
+              str_time_median,
+              str_time_mean,
+              str_time_stddev,
+              str_time_p95
+         );
+         for (i = 0; i < bots_number_of_phases; i++)
+            fprintf(stdout,"%s;", str_phases[i]);
+         if (bots_counters_flag) {
+            for (i = 0; i < BOTS_NUMBER_OF_COUNTERS; i++)
+               fprintf(stdout,"%s;", str_counters[i]);
+            fprintf(stdout,"%s;", str_ipc);
+         }
          fprintf(stdout,"\n");
          break;
+      case 5:
+         bots_print_structured(TRUE);
+         break;
+      case 6:
+         bots_print_structured(FALSE);
+         break;
       default:
          bots_error(BOTS_ERROR,"No valid output format\n");
          break;
@@ -46,11 +46,38 @@
 
 #define BOTS_WARNING                       0
 
+void bots_timer_init(void);
+const char *bots_timer_name(void);
+void bots_counters_init(void);
+void bots_counters_start(void);
+void bots_counters_stop(void);
+void bots_counters_reset(void);
 void bots_get_date(char *str);
 void bots_get_architecture(char *str);
 void bots_get_load_average(char *str);
+void bots_get_cpu_model(char *str);
+void bots_get_affinity(char *str);
+void bots_compute_time_statistics(double *samples, int n);
+void bots_phases_reset(void);
+void bots_print_sweep(int n, int *threads, double *times);
 void bots_print_results(void);
 
 #define BOTS_TMP_STR_SZ 256
 
+#define BOTS_MAX_SWEEP_POINTS 64
+
+#define BOTS_MAX_PHASES 16
+#define BOTS_PHASE_NAME_SZ 32
+
+typedef struct {
+   char name[BOTS_PHASE_NAME_SZ];
+   double start;
+   double total;
+   int calls;
+   int running;
+} bots_phase_t;
+
+extern bots_phase_t bots_phases[];
+extern int bots_number_of_phases;
+
 #endif
@@ -41,9 +41,11 @@
 int bots_sequential_flag = FALSE;
 int bots_check_flag = FALSE;
 bots_verbose_mode_t bots_verbose_mode = BOTS_VERBOSE_DEFAULT;
+bots_timer_t bots_timer = BOTS_TIMER_MONOTONIC;
 int bots_result = BOTS_RESULT_NOT_REQUESTED;
 int bots_output_format = 1;
 int bots_print_header = FALSE;
+int bots_counters_flag = FALSE;
 /* common variables */
 char bots_name[BOTS_TMP_STR_SZ];
 char bots_execname[BOTS_TMP_STR_SZ];
@@ -66,6 +68,22 @@ double bots_time_program = 0.0;
 double bots_time_sequential = 0.0;
 unsigned long long bots_number_of_tasks = 0; /* forcing 8 bytes size in -m32 and -m64 */
 
+/* sweep variables */
+int bots_num_threads = 0;
+int bots_sweep_threads[BOTS_MAX_SWEEP_POINTS];
+double bots_sweep_times[BOTS_MAX_SWEEP_POINTS];
+int bots_sweep_points = 0;
+
+/* repetition variables */
+int bots_repetitions = 1;
+int bots_warmups = 0;
+double *bots_time_samples = NULL;
+double bots_time_min = 0.0;
+double bots_time_median = 0.0;
+double bots_time_mean = 0.0;
+double bots_time_stddev = 0.0;
+double bots_time_p95 = 0.0;
+
 /*
  * Application dependent info
  */
@@ -144,16 +162,6 @@ int bots_arg_size_1 = BOTS_APP_DEF_ARG_SIZE_1;
 int bots_arg_size_2 = BOTS_APP_DEF_ARG_SIZE_2;
 #endif
 
-#ifdef BOTS_APP_USES_ARG_REPETITIONS
-#ifndef BOTS_APP_DEF_ARG_REPETITIONS
-#error "Default vaule for argument repetitions must be specified (#define BOTS_APP_DEF_ARG_REPETITIONS)"
-#endif
-#ifndef BOTS_APP_DESC_ARG_REPETITIONS
-#error "Help description for argument repetitions must be specified (#define BOTS_APP_DESC_ARG_REPETITIONS)"
-#endif
-int bots_arg_repetitions = BOTS_APP_DEF_ARG_REPETITIONS;
-#endif
-
 #ifdef BOTS_APP_USES_ARG_FILE
 #ifndef BOTS_APP_DESC_ARG_FILE
 #error "Help description for argument file must be specified (#define BOTS_APP_DESC_ARG_FILE)"
@@ -214,9 +222,6 @@ void bots_print_usage()
    fprintf(stderr, "Usage: %s -[options]\n", bots_execname);
    fprintf(stderr, "\n");
    fprintf(stderr, "Where options are:\n");
-#ifdef BOTS_APP_USES_REPETITIONS
-   fprintf(stderr, "  -r <value> : Set the number of repetitions (default = 1).\n");
-#endif
 #ifdef BOTS_APP_USES_ARG_SIZE
    fprintf(stderr, "  -n <size>  : "BOTS_APP_DESC_ARG_SIZE"\n");
 #endif
@@ -254,7 +259,20 @@ void bots_print_usage()
    fprintf(stderr, "               2 - detailed row format.\n");
    fprintf(stderr, "               3 - abridged list format.\n");
    fprintf(stderr, "               4 - abridged row format.\n");
-   fprintf(stderr, "  -z         : Print row header (if output format is a row variant).\n");
+   fprintf(stderr, "               5 - JSON lines format (one object per run).\n");
+   fprintf(stderr, "               6 - CSV format.\n");
+   fprintf(stderr, "  -z         : Print row header (if output format is a row or CSV variant).\n");
+   fprintf(stderr, "\n");
+   fprintf(stderr, "  -r <value> : Set the number of timed repetitions (default = 1).\n");
+   fprintf(stderr, "               Time Program reports the median of all of them.\n");
+   fprintf(stderr, "  -w <value> : Set the number of untimed warm-up repetitions (default = 0).\n");
+   fprintf(stderr, "  -T <list>  : Run the kernel once per number of threads in the comma\n");
+   fprintf(stderr, "               separated list (e.g. 1,2,4,8), reusing the initialized\n");
+   fprintf(stderr, "               input, and print a speed-up/efficiency table.\n");
+   fprintf(stderr, "  -p         : Collect hardware performance counters around the kernel.\n");
+   fprintf(stderr, "  -t <timer> : Set the timer used for measurements (default = monotonic).\n");
+   fprintf(stderr, "               monotonic - clock_gettime(CLOCK_MONOTONIC_RAW).\n");
+   fprintf(stderr, "               tsc       - invariant time-stamp counter, calibrated at startup.\n");
    fprintf(stderr, "\n");
 #ifdef KERNEL_SEQ_CALL
    fprintf(stderr, "  -s         : Run sequential version.\n");
@@ -268,6 +286,29 @@ void bots_print_usage()
    fprintf(stderr, "  -h         : Print program's usage (this help).\n");
    fprintf(stderr, "\n");
 }
+/***********************************************************************
+ * bots_get_sweep_list: parses a comma separated list of threads
+ **********************************************************************/
+static void
+bots_get_sweep_list(char *list)
+{
+   char *token;
+
+   bots_sweep_points = 0;
+   for (token = strtok(list, ","); token != NULL; token = strtok(NULL, ",")) {
+      if (bots_sweep_points == BOTS_MAX_SWEEP_POINTS) {
+         fprintf(stderr, "Error: Too many points in the threads list (maximum is %d).\n", BOTS_MAX_SWEEP_POINTS);
+         exit(100);
+      }
+      bots_sweep_threads[bots_sweep_points] = atoi(token);
+      if (bots_sweep_threads[bots_sweep_points] < 1) {
+         fprintf(stderr, "Error: Invalid number of threads '%s'.\n", token);
+         exit(100);
+      }
+      bots_sweep_points++;
+   }
+}
+
 /***********************************************************************
  * bots_get_params_common: 
  **********************************************************************/
@@ -358,14 +399,20 @@ bots_get_params_common(int argc, char **argv)
                if (argc == i) { bots_print_usage(); exit(100); }
                bots_output_format = atoi(argv[i]);
                break;
-#ifdef BOTS_APP_USES_REPETITIONS
+            case 'p': /* enable performance counters */
+               argv[i][1] = '*';
+               bots_counters_flag = TRUE;
+               break;
             case 'r': /* set number of repetitions */
                argv[i][1] = '*';
                i++;
                if (argc == i) { bots_print_usage(); exit(100); }
-               bots_arg_repetition = atoi(argv[i]);
+               bots_repetitions = atoi(argv[i]);
+               if ( bots_repetitions < 1 ) {
+                  fprintf(stderr, "Error: The number of repetitions must be at least 1.\n");
+                  exit(100);
+               }
                break;
-#endif
 #ifdef KERNEL_SEQ_CALL
             case 's': /* set sequential execution */
                argv[i][1] = '*';
@@ -375,6 +422,23 @@ bots_get_params_common(int argc, char **argv)
                bots_sequential_flag = TRUE;
                break;
 #endif
+            case 'T': /* set the list of threads for a sweep */
+               argv[i][1] = '*';
+               i++;
+               if (argc == i) { bots_print_usage(); exit(100); }
+               bots_get_sweep_list(argv[i]);
+               break;
+            case 't': /* set timer */
+               argv[i][1] = '*';
+               i++;
+               if (argc == i) { bots_print_usage(); exit(100); }
+               if (strcmp(argv[i], "monotonic") == 0) bots_timer = BOTS_TIMER_MONOTONIC;
+               else if (strcmp(argv[i], "tsc") == 0) bots_timer = BOTS_TIMER_TSC;
+               else {
+                  fprintf(stderr, "Error: Unrecognized timer '%s'.\n", argv[i]);
+                  exit(100);
+               }
+               break;
             case 'v': /* set/unset verbose level */
                argv[i][1] = '*';
                i++;
@@ -387,6 +451,16 @@ bots_get_params_common(int argc, char **argv)
                }
 #endif
                break;
+            case 'w': /* set number of warm-up repetitions */
+               argv[i][1] = '*';
+               i++;
+               if (argc == i) { bots_print_usage(); exit(100); }
+               bots_warmups = atoi(argv[i]);
+               if ( bots_warmups < 0 ) {
+                  fprintf(stderr, "Error: The number of warm-up repetitions can not be negative.\n");
+                  exit(100);
+               }
+               break;
 #if defined(MANUAL_CUTOFF) || defined(IF_CUTOFF) || defined(FINAL_CUTOFF)
 	    case 'x':
 	       argv[i][1] = '*';
@@ -477,12 +551,17 @@ int
 main(int argc, char* argv[])
 {
 #ifndef BOTS_APP_SELF_TIMING
-   long bots_t_start;
-   long bots_t_end;
+   double bots_t_start;
+   double bots_t_end;
 #endif
+   int bots_rep, bots_point;
 
    bots_get_params(argc,argv);
+   bots_timer_init();
+   bots_counters_init();
+   bots_phase_begin("app_init");
    BOTS_APP_INIT;
+   bots_phase_end("app_init");
    bots_set_info();
 
 #ifdef KERNEL_SEQ_CALL
@@ -497,35 +576,73 @@ main(int argc, char* argv[])
 #ifdef BOTS_APP_SELF_TIMING
       bots_time_sequential = KERNEL_SEQ_CALL;
 #else
-      bots_t_start = bots_usecs();
+      bots_t_start = bots_seconds();
       KERNEL_SEQ_CALL;
-      bots_t_end = bots_usecs();
-      bots_time_sequential = ((double)(bots_t_end-bots_t_start))/1000000;
+      bots_t_end = bots_seconds();
+      bots_time_sequential = bots_t_end-bots_t_start;
 #endif
       KERNEL_SEQ_FINI;
    }
 #endif
 
-   KERNEL_INIT;
+   bots_time_samples = (double *) malloc(bots_repetitions * sizeof(double));
+   if (bots_time_samples == NULL) bots_error(BOTS_ERROR_NOT_ENOUGH_MEMORY, NULL);
+
+   /* without a sweep there is a single point using the default threads */
+   for (bots_point = 0; bots_point < bots_sweep_points || bots_point == 0; bots_point++)
+   {
+      if (bots_sweep_points > 0) {
+         bots_num_threads = bots_sweep_threads[bots_point];
+         omp_set_num_threads(bots_num_threads);
+         snprintf(bots_resources, BOTS_TMP_STR_SZ, "%d", omp_get_max_threads());
+         if (bots_point > 0) {
+            bots_phases_reset();
+            bots_counters_reset();
+         }
+      }
+
+      /* negative repetitions are warm-up runs and are not recorded */
+      for (bots_rep = -bots_warmups; bots_rep < bots_repetitions; bots_rep++)
+      {
+         bots_phase_begin("kernel_init");
+         KERNEL_INIT;
+         bots_phase_end("kernel_init");
+         bots_number_of_tasks = 0;
+         if (bots_rep >= 0) bots_counters_start();
 #ifdef BOTS_APP_SELF_TIMING
-   bots_time_program = KERNEL_CALL;
+         bots_time_program = KERNEL_CALL;
 #else
-   bots_t_start = bots_usecs();
-   KERNEL_CALL;
-   bots_t_end = bots_usecs();
-   bots_time_program = ((double)(bots_t_end-bots_t_start))/1000000;
-#endif
-   KERNEL_FINI;
+         bots_t_start = bots_seconds();
+         KERNEL_CALL;
+         bots_t_end = bots_seconds();
+         bots_time_program = bots_t_end-bots_t_start;
+#endif
+         if (bots_rep >= 0) bots_counters_stop();
+         bots_phase_begin("kernel_fini");
+         KERNEL_FINI;
+         bots_phase_end("kernel_fini");
+         if (bots_rep >= 0) bots_time_samples[bots_rep] = bots_time_program;
+      }
+
+      bots_compute_time_statistics(bots_time_samples, bots_repetitions);
+      bots_time_program = bots_time_median;
 
 #ifdef KERNEL_CHECK
-   if (bots_check_flag) {
-     bots_result = KERNEL_CHECK;
-   }
+      if (bots_check_flag) {
+        bots_phase_begin("check");
+        bots_result = KERNEL_CHECK;
+        bots_phase_end("check");
+      }
 #endif
 
+      bots_print_results();
+      bots_print_header = FALSE;
+      bots_sweep_times[bots_point] = bots_time_program;
+   }
+
    BOTS_APP_FINI;
 
-   bots_print_results();
+   if (bots_sweep_points > 0) bots_print_sweep(bots_sweep_points, bots_sweep_threads, bots_sweep_times);
    return (0);
 }
 
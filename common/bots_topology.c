@@ -0,0 +1,375 @@
+/**********************************************************************************************/
+/*  This program is part of the Barcelona OpenMP Tasks Suite                                  */
+/*  Copyright (C) 2009 Barcelona Supercomputing Center - Centro Nacional de Supercomputacion  */
+/*  Copyright (C) 2009 Universitat Politecnica de Catalunya                                   */
+/*                                                                                            */
+/*  This program is free software; you can redistribute it and/or modify                      */
+/*  it under the terms of the GNU General Public License as published by                      */
+/*  the Free Software Foundation; either version 2 of the License, or                         */
+/*  (at your option) any later version.                                                       */
+/*                                                                                            */
+/*  This program is distributed in the hope that it will be useful,                           */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of                            */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                             */
+/*  GNU General Public License for more details.                                              */
+/*                                                                                            */
+/*  You should have received a copy of the GNU General Public License                         */
+/*  along with this program; if not, write to the Free Software                               */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA            */
+/**********************************************************************************************/
+
+/*
+ * Places and thread binding for runtimes that do not implement OMP_PLACES
+ * and OMP_PROC_BIND themselves (e.g. oneTBB). The places are built from the
+ * CPU topology in /sys/devices/system, following the OpenMP rules, so that
+ * a thread is bound to the same CPUs whatever programming model is used.
+ */
+
+#if defined (__linux)
+#define _GNU_SOURCE
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "bots_common.h"
+#include "bots.h"
+
+#if defined (__linux)
+
+#define BOTS_MAX_PLACES 1024
+#define BOTS_MAX_NODES 64
+
+typedef enum { BOTS_PLACES_THREADS=0,
+               BOTS_PLACES_CORES,
+               BOTS_PLACES_SOCKETS,
+               BOTS_PLACES_NUMA_DOMAINS } bots_places_t;
+
+typedef enum { BOTS_BIND_NONE=0,
+               BOTS_BIND_PRIMARY,
+               BOTS_BIND_CLOSE,
+               BOTS_BIND_SPREAD } bots_bind_t;
+
+static int bots_topology_ready = FALSE;
+static bots_places_t bots_places_kind = BOTS_PLACES_THREADS;
+static bots_bind_t bots_bind = BOTS_BIND_NONE;
+static cpu_set_t bots_places[BOTS_MAX_PLACES];
+static int bots_place_node[BOTS_MAX_PLACES];
+static int bots_number_of_places = 0;
+static cpu_set_t bots_nodes[BOTS_MAX_NODES];
+static int bots_node_id[BOTS_MAX_NODES];
+static int bots_number_of_nodes = 0;
+
+/* parses a sysfs cpu list (e.g. 0-3,8-11) */
+static int bots_read_cpulist(const char *path, cpu_set_t *set)
+{
+   FILE *file;
+   int first, last, cpu;
+   char sep;
+
+   CPU_ZERO(set);
+   if ((file = fopen(path, "r")) == NULL) return FALSE;
+   while (fscanf(file, "%d", &first) == 1) {
+      last = first;
+      sep = fgetc(file);
+      if (sep == '-') {
+         if (fscanf(file, "%d", &last) != 1) break;
+         sep = fgetc(file);
+      }
+      for (cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++) CPU_SET(cpu, set);
+      if (sep != ',') break;
+   }
+   fclose(file);
+   return CPU_COUNT(set) > 0;
+}
+
+static int bots_read_cpu_group(int cpu, const char *name, const char *fallback, cpu_set_t *set)
+{
+   char path[BOTS_TMP_STR_SZ];
+
+   snprintf(path, BOTS_TMP_STR_SZ, "/sys/devices/system/cpu/cpu%d/topology/%s", cpu, name);
+   if (bots_read_cpulist(path, set)) return TRUE;
+   snprintf(path, BOTS_TMP_STR_SZ, "/sys/devices/system/cpu/cpu%d/topology/%s", cpu, fallback);
+   return bots_read_cpulist(path, set);
+}
+
+static int bots_cpu_node(int cpu)
+{
+   int node;
+
+   for (node = 0; node < bots_number_of_nodes; node++)
+      if (CPU_ISSET(cpu, &bots_nodes[node])) return node;
+   return 0;
+}
+
+static void bots_read_nodes(void)
+{
+   char path[BOTS_TMP_STR_SZ];
+   int node;
+
+   /* node ids may have holes, only the nodes with CPUs are kept */
+   for (node = 0; node < BOTS_MAX_NODES; node++) {
+      snprintf(path, BOTS_TMP_STR_SZ, "/sys/devices/system/node/node%d/cpulist", node);
+      if (!bots_read_cpulist(path, &bots_nodes[bots_number_of_nodes])) continue;
+      bots_node_id[bots_number_of_nodes++] = node;
+   }
+}
+
+/* OMP_PLACES=threads|cores|sockets|numa_domains[(count)] */
+static int bots_parse_places(const char *places, int *count)
+{
+   static const char *names[] = { "threads", "cores", "sockets", "numa_domains" };
+   size_t len;
+   int i;
+
+   *count = BOTS_MAX_PLACES;
+   if (places == NULL) return TRUE;
+   while (*places == ' ') places++;
+   for (i = 0; i < 4; i++) {
+      len = strlen(names[i]);
+      if (strncasecmp(places, names[i], len) != 0) continue;
+      bots_places_kind = (bots_places_t) i;
+      if (places[len] == '(') *count = atoi(places + len + 1);
+      else if (places[len] != '\0' && places[len] != ' ') return FALSE;
+      return *count > 0;
+   }
+   return FALSE;
+}
+
+/* only the first entry of OMP_PROC_BIND applies to a single level of parallelism */
+static void bots_parse_proc_bind(const char *bind)
+{
+   if (bind == NULL) return;
+   while (*bind == ' ') bind++;
+   /* true uses close, as libgomp does */
+   if (strncasecmp(bind, "close", 5) == 0 || strncasecmp(bind, "true", 4) == 0) bots_bind = BOTS_BIND_CLOSE;
+   else if (strncasecmp(bind, "spread", 6) == 0) bots_bind = BOTS_BIND_SPREAD;
+   else if (strncasecmp(bind, "master", 6) == 0 || strncasecmp(bind, "primary", 7) == 0) bots_bind = BOTS_BIND_PRIMARY;
+}
+
+static void bots_topology_init(void)
+{
+   cpu_set_t allowed, assigned, place;
+   int cpu, count, found;
+
+   if (bots_topology_ready) return;
+   bots_topology_ready = TRUE;
+
+   if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+      CPU_ZERO(&allowed);
+      CPU_SET(0, &allowed);
+   }
+   bots_read_nodes();
+
+   if (!bots_parse_places(getenv("OMP_PLACES"), &count)) {
+      bots_warning(BOTS_WARNING, "Unsupported OMP_PLACES value, using threads.");
+      bots_places_kind = BOTS_PLACES_THREADS;
+      count = BOTS_MAX_PLACES;
+   }
+   bots_parse_proc_bind(getenv("OMP_PROC_BIND"));
+
+   /* places are ordered by their lowest CPU, as done by the OpenMP runtimes */
+   CPU_ZERO(&assigned);
+   for (cpu = 0; cpu < CPU_SETSIZE && bots_number_of_places < count; cpu++) {
+      if (!CPU_ISSET(cpu, &allowed) || CPU_ISSET(cpu, &assigned)) continue;
+
+      switch (bots_places_kind) {
+         case BOTS_PLACES_CORES:
+            found = bots_read_cpu_group(cpu, "core_cpus_list", "thread_siblings_list", &place);
+            break;
+         case BOTS_PLACES_SOCKETS:
+            found = bots_read_cpu_group(cpu, "package_cpus_list", "core_siblings_list", &place);
+            break;
+         case BOTS_PLACES_NUMA_DOMAINS:
+            found = bots_number_of_nodes > 0;
+            if (found) place = bots_nodes[bots_cpu_node(cpu)];
+            break;
+         default:
+            found = FALSE;
+            break;
+      }
+      if (!found) {
+         CPU_ZERO(&place);
+         CPU_SET(cpu, &place);
+      }
+      CPU_AND(&place, &place, &allowed);
+      CPU_OR(&assigned, &assigned, &place);
+
+      bots_places[bots_number_of_places] = place;
+      bots_place_node[bots_number_of_places] = bots_cpu_node(cpu);
+      bots_number_of_places++;
+      if (bots_number_of_places == BOTS_MAX_PLACES) break;
+   }
+   bots_debug("Topology: %d places, %d NUMA nodes\n", bots_number_of_places, bots_number_of_nodes);
+}
+
+int bots_get_num_places(void)
+{
+   bots_topology_init();
+   return bots_number_of_places;
+}
+
+int bots_get_num_nodes(void)
+{
+   bots_topology_init();
+   return bots_number_of_nodes > 0 ? bots_number_of_nodes : 1;
+}
+
+int bots_get_place_node(int place)
+{
+   bots_topology_init();
+   if (place < 0 || place >= bots_number_of_places) return 0;
+   return bots_place_node[place];
+}
+
+int bots_places_are_cores(void)
+{
+   bots_topology_init();
+   return getenv("OMP_PLACES") != NULL && bots_places_kind == BOTS_PLACES_CORES;
+}
+
+/* operating system id of a node (as used by libnuma, hwloc or oneTBB) */
+int bots_get_node_id(int node)
+{
+   bots_topology_init();
+   if (node < 0 || node >= bots_number_of_nodes) return -1;
+   return bots_node_id[node];
+}
+
+/* node holding the page at addr, -1 if unknown or not touched yet */
+int bots_get_address_node(const void *addr)
+{
+   int id, node;
+
+   bots_topology_init();
+   if (syscall(SYS_get_mempolicy, &id, NULL, 0, addr, MPOL_F_NODE | MPOL_F_ADDR) != 0) return -1;
+   for (node = 0; node < bots_number_of_nodes; node++)
+      if (bots_node_id[node] == id) return node;
+   return -1;
+}
+
+int bots_bind_to_node(int node)
+{
+   bots_topology_init();
+   if (node < 0 || node >= bots_number_of_nodes) return -1;
+   if (sched_setaffinity(0, sizeof(cpu_set_t), &bots_nodes[node]) != 0) {
+      bots_warning(BOTS_WARNING, "Could not bind a thread to its NUMA node.");
+      return -1;
+   }
+   return node;
+}
+
+/*
+ * Place of the thread-th thread of a team of nthreads (the primary thread is
+ * thread 0). With close, consecutive threads go to consecutive places; with
+ * spread, the places are split in nthreads partitions and each thread takes
+ * the first place of its own. When there are more threads than places both
+ * policies assign nthreads/places consecutive threads to each place.
+ */
+int bots_get_thread_place(int thread, int nthreads)
+{
+   bots_topology_init();
+   if (bots_bind == BOTS_BIND_NONE || bots_number_of_places == 0) return -1;
+   if (bots_bind == BOTS_BIND_PRIMARY) return 0;
+   if (nthreads < 1) nthreads = 1;
+   thread %= nthreads;
+   if (bots_bind == BOTS_BIND_CLOSE && nthreads <= bots_number_of_places) return thread;
+   return (int) ((long) thread * bots_number_of_places / nthreads);
+}
+
+int bots_bind_thread(int thread, int nthreads)
+{
+   int place = bots_get_thread_place(thread, nthreads);
+
+   if (place == -1) return -1;
+   if (sched_setaffinity(0, sizeof(cpu_set_t), &bots_places[place]) != 0) {
+      bots_warning(BOTS_WARNING, "Could not bind a thread to its place.");
+      return -1;
+   }
+   return place;
+}
+
+/*
+ * Parallel first-touch initialization. The range is split in contiguous,
+ * page aligned chunks, one per thread, and each thread is bound as the
+ * kernel threads would be (or spread over the NUMA nodes when they are not
+ * bound) before touching its chunk, so the pages end up next to the threads
+ * that use them.
+ */
+#define BOTS_FIRST_TOUCH_MIN_BYTES (1 << 20)
+
+typedef struct {
+   pthread_t thread;
+   int id, nthreads;
+   long begin, end;
+   bots_init_fn init;
+   void *arg;
+} bots_first_touch_t;
+
+static void *bots_first_touch_thread(void *data)
+{
+   bots_first_touch_t *chunk = (bots_first_touch_t *) data;
+
+   if (bots_bind_thread(chunk->id, chunk->nthreads) == -1 && bots_number_of_nodes > 1)
+      bots_bind_to_node((int) ((long) chunk->id * bots_number_of_nodes / chunk->nthreads));
+   chunk->init(chunk->arg, chunk->begin, chunk->end);
+   return NULL;
+}
+
+void bots_first_touch(long n, size_t size, int nthreads, bots_init_fn init, void *arg)
+{
+   bots_first_touch_t *chunks;
+   long per_page, chunk;
+   int i, started;
+
+   bots_topology_init();
+   if (nthreads > n) nthreads = (int) n;
+   if (nthreads <= 1 || n * size < BOTS_FIRST_TOUCH_MIN_BYTES) {
+      init(arg, 0, n);
+      return;
+   }
+
+   per_page = sysconf(_SC_PAGESIZE) / size;
+   if (per_page < 1) per_page = 1;
+   chunk = (n + nthreads - 1) / nthreads;
+   chunk = (chunk + per_page - 1) / per_page * per_page;
+
+   chunks = (bots_first_touch_t *) malloc(nthreads * sizeof(bots_first_touch_t));
+   if (chunks == NULL) bots_error(BOTS_ERROR_NOT_ENOUGH_MEMORY, NULL);
+   for (i = 0, started = 0; i < nthreads; i++) {
+      chunks[i].id = i;
+      chunks[i].nthreads = nthreads;
+      chunks[i].begin = i * chunk < n ? i * chunk : n;
+      chunks[i].end = chunks[i].begin + chunk < n ? chunks[i].begin + chunk : n;
+      chunks[i].init = init;
+      chunks[i].arg = arg;
+      if (chunks[i].begin == chunks[i].end) break;
+      if (pthread_create(&chunks[i].thread, NULL, bots_first_touch_thread, &chunks[i]) != 0) {
+         /* the rest is done by the calling thread */
+         init(arg, chunks[i].begin, n);
+         break;
+      }
+      started++;
+   }
+   for (i = 0; i < started; i++) pthread_join(chunks[i].thread, NULL);
+   free(chunks);
+}
+
+#else
+int bots_get_num_places(void) { return 1; }
+int bots_get_num_nodes(void) { return 1; }
+int bots_get_place_node(int place) { return 0; }
+int bots_places_are_cores(void) { return FALSE; }
+int bots_get_node_id(int node) { return -1; }
+int bots_get_address_node(const void *addr) { return -1; }
+int bots_bind_to_node(int node) { return -1; }
+int bots_get_thread_place(int thread, int nthreads) { return -1; }
+int bots_bind_thread(int thread, int nthreads) { return -1; }
+void bots_first_touch(long n, size_t size, int nthreads, bots_init_fn init, void *arg) { init(arg, 0, n); }
+#endif
@@ -26,4 +26,11 @@
 #define BOTS_MODEL_DESC "oneTBB (using tasks?)"
 #endif
 
+/* The number of threads is the concurrency of the arena (see arena.cpp) */
+#ifdef __cplusplus
+extern "C"
+#endif
+int arena_max_concurrency();
+#undef omp_get_max_threads
+#define omp_get_max_threads() arena_max_concurrency()
 
@@ -633,7 +633,7 @@ void pairalign_init (char *filename)
 void align_init ()
 {
    int i,j;
-   bench_output = (int *) malloc(sizeof(int)*nseqs*nseqs);
+   if (bench_output == NULL) bench_output = (int *) malloc(sizeof(int)*nseqs*nseqs);
 
    for(i = 0; i<nseqs; i++)
       for(j = 0; j<nseqs; j++)
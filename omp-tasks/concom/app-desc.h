@@ -39,13 +39,6 @@
 #define BOTS_APP_DEF_ARG_SIZE_2 100000
 #define BOTS_APP_DESC_ARG_SIZE_2 "Number of links in the entire graph"
 
-typedef struct node {
-    int   n;
-    int  *neighbor;
-}node;
-
-
-int linkable(int N1, int N2);
 void initialize();
 void write_outputs(int n, int cc);
 void CC_par (int i, int cc);
@@ -22,6 +22,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <sys/time.h>
+#include <omp.h>
 #include "app-desc.h"
 #include "bots.h"
 
@@ -29,36 +30,125 @@
 // bots_arg_size_1 == Maximum number of neighbors per node
 // bots_arg_size_2 == Number of links in the entire graph
 
-node *nodes;
-int *visited, *components;
+long *offsets;
+int *adjacency, *visited, *components;
 
-// Checks to see if two nodes can be linked
-int linkable(int N1, int N2) {
-    int i;
+/* The graph is stored in CSR form: the neighbors of node i are
+ * adjacency[offsets[i]] .. adjacency[offsets[i+1]-1], sorted */
+
+static int *degree, *stack, *frontier;
+static int (*edges)[2];
+static long nedges;
+
+/* set of the links already generated (open addressing on the node pair) */
+static unsigned long long *link_set;
+static unsigned long link_mask;
+
+// Checks to see if two nodes can be linked, and records the link if so
+static int new_link(int N1, int N2) {
+    unsigned long long key;
+    unsigned long h;
 
     if (N1 == N2) return (0);
-    if (nodes[N1].n >= bots_arg_size_1) return (0);
-    if (nodes[N2].n >= bots_arg_size_1) return (0);
-    
-    for (i = 0; i < nodes[N1].n; i++)
-        if (nodes[N1].neighbor[i] == N2) return (0);
+    if (degree[N1] >= bots_arg_size_1) return (0);
+    if (degree[N2] >= bots_arg_size_1) return (0);
+
+    /* +1 so that 0 marks an empty slot */
+    key = N1 < N2 ? ((unsigned long long) N1 << 32 | N2) : ((unsigned long long) N2 << 32 | N1);
+    key++;
+    h = (unsigned long) ((key * 0x9E3779B97F4A7C15ULL) >> 32) & link_mask;
+    while (link_set[h] != 0) {
+        if (link_set[h] == key) return (0);
+        h = (h + 1) & link_mask;
+    }
+    link_set[h] = key;
 
     return (1);
 }
+// Builds the CSR arrays from the edge list in parallel
+static void build_csr() {
+   long *partial;
+   int i;
+
+   offsets = (long *) malloc((bots_arg_size + 1) * sizeof(long));
+   adjacency = (int *) malloc((2 * nedges + 1) * sizeof(int));
+   partial = (long *) malloc((omp_get_max_threads() + 1) * sizeof(long));
+   if (offsets == NULL || adjacency == NULL || partial == NULL) {
+      bots_message("Error: Out of memory\n");
+      exit(101);
+   }
+
+   #pragma omp parallel private(i)
+   {
+      /* offsets: prefix sum of the degrees, one block per thread */
+      int t = omp_get_thread_num(), nt = omp_get_num_threads();
+      int lo = (long) bots_arg_size * t / nt, hi = (long) bots_arg_size * (t + 1) / nt;
+      long e, sum = 0;
+
+      for (i = lo; i < hi; i++) sum += degree[i];
+      partial[t + 1] = sum;
+      #pragma omp barrier
+      #pragma omp single
+      {
+         partial[0] = 0;
+         for (i = 0; i < nt; i++) partial[i + 1] += partial[i];
+      }
+      sum = partial[t];
+      for (i = lo; i < hi; i++) {
+         offsets[i] = sum;
+         sum += degree[i];
+         degree[i] = 0;   /* reused as the fill cursor */
+      }
+      #pragma omp barrier
+
+      /* scatter both ends of every link */
+      #pragma omp for
+      for (e = 0; e < nedges; e++) {
+         int N1 = edges[e][0], N2 = edges[e][1], l1, l2;
+         #pragma omp atomic capture
+         l1 = degree[N1]++;
+         #pragma omp atomic capture
+         l2 = degree[N2]++;
+         adjacency[offsets[N1] + l1] = N2;
+         adjacency[offsets[N2] + l2] = N1;
+      }
+
+      /* the scatter order depends on the schedule; sort the lists */
+      #pragma omp for schedule(dynamic, 4096)
+      for (i = 0; i < bots_arg_size; i++) {
+         long j, k, lo_i = offsets[i], hi_i = offsets[i] + degree[i];
+         for (j = lo_i + 1; j < hi_i; j++) {
+            int v = adjacency[j];
+            for (k = j; k > lo_i && adjacency[k-1] > v; k--) adjacency[k] = adjacency[k-1];
+            adjacency[k] = v;
+         }
+      }
+   }
+   offsets[bots_arg_size] = 2 * nedges;
+   free(partial);
+}
 // Allocates and creates a graph with random links between nodes
 // also allocates visited and components vectors
 void initialize() {
-   int i, l1, l2, N1, N2;
+   int i, N1, N2;
+   unsigned long slots;
    double RN;
    
-   nodes = (node *) malloc(bots_arg_size * sizeof(node)); 
+   degree = (int *) calloc(bots_arg_size, sizeof(int));
+   edges = (int (*)[2]) malloc(bots_arg_size_2 * sizeof(*edges));
+   for (slots = 1024; slots < 2 * (unsigned long) bots_arg_size_2; slots *= 2);
+   link_set = (unsigned long long *) calloc(slots, sizeof(unsigned long long));
+   link_mask = slots - 1;
    visited = (int *) malloc(bots_arg_size * sizeof(int)); 
    components = (int *) malloc(bots_arg_size * sizeof(int)); 
-   /* initialize nodes */
-   for (i = 0; i < bots_arg_size; i++) {
-      nodes[i].n = 0;
-      nodes[i].neighbor = (int *) malloc(bots_arg_size_1 * sizeof(int));
+   stack = (int *) malloc(bots_arg_size * sizeof(int));
+   frontier = (int *) malloc(bots_arg_size * sizeof(int));
+   if (degree == NULL || edges == NULL || link_set == NULL ||
+       visited == NULL || components == NULL || stack == NULL || frontier == NULL) {
+      bots_message("Error: Out of memory\n");
+      exit(101);
    }
+   nedges = 0;
    /* for each link, generate end nodes and link */
    for (i = 0; i < bots_arg_size_2; i++)
    {
@@ -66,15 +156,19 @@ void initialize() {
       N1 = (int) ((bots_arg_size-1) * RN);
       RN = rand() / (double) RAND_MAX;
       N2 = (int) ((bots_arg_size-1) * RN);
-      if (linkable(N1, N2)) {
-         l1 = nodes[N1].n;
-         l2 = nodes[N2].n;
-         nodes[N1].neighbor[l1] = N2;
-         nodes[N2].neighbor[l2] = N1;
-         nodes[N1].n += 1;
-         nodes[N2].n += 1;
+      if (new_link(N1, N2)) {
+         edges[nedges][0] = N1;
+         edges[nedges][1] = N2;
+         degree[N1] += 1;
+         degree[N2] += 1;
+         nedges++;
       }   
    }
+   free(link_set);
+
+   build_csr();
+   free(edges);
+   free(degree);
 }
 // Writes the number of CCs
 void write_outputs(int n, int cc) {
@@ -86,47 +180,95 @@ void write_outputs(int n, int cc) {
      for (i = 0; i < cc; i++)
          printf("Component %d       Size: %d\n", i, components[i]);
 }
-// Marks a node and all its neighbors as part of the CC
-void CC_par (int i, int cc)
+/* Frontier nodes expanded by one task, and neighbors a task gathers
+ * before reserving room for them in the next frontier */
+#define CC_CHUNK 1024
+#define CC_BUFFER 256
+
+static void CC_flush(int *buf, int nbuf, int *next, long *nnext)
 {
-   int j, n;
-   /* if node has not been visited */
-   if (visited[i] == 0) {
-      /* add node to current component */
-      if (bots_verbose_mode) printf("Adding node %d to component %d\n", i, cc);
-      #pragma omp critical
+   long at;
+
+   #pragma omp atomic capture
+   { at = *nnext; *nnext += nbuf; }
+   memcpy(next + at, buf, nbuf * sizeof(int));
+}
+// Adds the unvisited neighbors of front[lo..hi) to the next frontier
+static void CC_expand(int *front, long lo, long hi, int *next, long *nnext)
+{
+   int buf[CC_BUFFER];
+   int n, nbuf = 0;
+   long i, j;
+
+   for (i = lo; i < hi; i++)
+      for (j = offsets[front[i]]; j < offsets[front[i]+1]; j++)
       {
-         visited[i] = 1;
-         components[cc]++;
+         n = adjacency[j];
+         /* only the task that marks the node adds it */
+         if (visited[n] == 0 && __sync_bool_compare_and_swap(&visited[n], 0, 1)) {
+            buf[nbuf++] = n;
+            if (nbuf == CC_BUFFER) {
+               CC_flush(buf, nbuf, next, nnext);
+               nbuf = 0;
+            }
+         }
       }
-      /* add each neighbor's subtree to the current component */
-      for (j = 0; j < nodes[i].n; j++)
+   if (nbuf > 0) CC_flush(buf, nbuf, next, nnext);
+}
+// Marks a node and all its neighbors as part of the CC, one level at a
+// time: the frontier is split in chunks expanded by tasks, so the depth
+// of the component does not need call stack (stack and frontier hold
+// the current and the next level)
+void CC_par (int i, int cc)
+{
+   int *front = stack, *next = frontier, *t;
+   long k, nfront = 1, nnext;
+
+   /* if node has not been visited */
+   if (visited[i] != 0) return;
+   visited[i] = 1;
+   front[0] = i;
+   while (nfront > 0) {
+      /* add the level to current component */
+      bots_debug("Adding %ld nodes to component %d\n", nfront, cc);
+      components[cc] += nfront;
+      nnext = 0;
+      for (k = 0; k < nfront; k += CC_CHUNK)
       {
-         n = nodes[i].neighbor[j];
-         #pragma omp task untied firstprivate (i,cc)
-         {CC_par(n, cc);}
+         long hi = k + CC_CHUNK < nfront ? k + CC_CHUNK : nfront;
+         #pragma omp task untied firstprivate (k,hi) shared (nnext)
+         CC_expand(front, k, hi, next, &nnext);
       }
       #pragma omp taskwait
-   }  
+      t = front; front = next; next = t;
+      nfront = nnext;
+   }
 }
+// Marks a node and all its neighbors as part of the CC, with an explicit
+// stack so that large components do not overflow the call stack
 void CC_seq (int i, int cc)
 {
-   int j, n;
+   long j;
+   int n, top = 0;
    /* if node has not been visited */
-   if (visited[i] == 0) {
+   if (visited[i] != 0) return;
+   visited[i] = 1;
+   stack[top++] = i;
+   while (top > 0) {
+      i = stack[--top];
       /* add node to current component */
-      if (bots_verbose_mode) printf("Adding node %d to component %d\n", i, cc);
-      {
-         visited[i] = 1;
-         components[cc]++;
-      }
-      /* add each neighbor's subtree to the current component */
-      for (j = 0; j < nodes[i].n; j++)
+      bots_debug("Adding node %d to component %d\n", i, cc);
+      components[cc]++;
+      /* add each unvisited neighbor to the current component */
+      for (j = offsets[i]; j < offsets[i+1]; j++)
       {
-         n = nodes[i].neighbor[j];
-         CC_seq(n, cc);
+         n = adjacency[j];
+         if (visited[n] == 0) {
+            visited[n] = 1;
+            stack[top++] = n;
+         }
       }
-   }  
+   }
 }
 void cc_init()
 {
@@ -166,7 +308,7 @@ void cc_seq(int *cc)
    {
       if (visited[i] == 0)
       {
-         CC_par(i, *cc);
+         CC_seq(i, *cc);
          (*cc)++;
       }
    }
@@ -31,14 +31,11 @@
 
 #define BOTS_APP_INIT int i;\
      COMPLEX *in, *out1=NULL, *out2=NULL;\
-     in = (COMPLEX *)malloc(bots_arg_size * sizeof(COMPLEX));\
+     in = fft_alloc(bots_arg_size);\
 
 #define KERNEL_INIT\
-     out1 = (COMPLEX *)malloc(bots_arg_size * sizeof(COMPLEX));\
-     for (i = 0; i < bots_arg_size; ++i) {\
-          c_re(in[i]) = 1.0;\
-          c_im(in[i]) = 1.0;\
-     }
+     if (out1 == NULL) out1 = fft_alloc(bots_arg_size);\
+     fft_init_input(bots_arg_size, in);
 #define KERNEL_CALL fft(bots_arg_size, in, out1);
 #define KERNEL_FINI 
 
@@ -4773,6 +4773,40 @@ void fft_aux_seq(int n, COMPLEX * in, COMPLEX * out, int *factors, COMPLEX * W,
 
      return;
 }
+static void clear_range(void *arg, long begin, long end)
+{
+     memset((COMPLEX *) arg + begin, 0, (end - begin) * sizeof(COMPLEX));
+}
+
+static void fill_input_range(void *arg, long begin, long end)
+{
+     COMPLEX *in = (COMPLEX *) arg;
+     long i;
+
+     for (i = begin; i < end; ++i) {
+          c_re(in[i]) = 1.0;
+          c_im(in[i]) = 1.0;
+     }
+}
+
+/* vectors are first touched in parallel to spread their pages */
+COMPLEX *fft_alloc(int n)
+{
+     COMPLEX *v = (COMPLEX *)malloc(n * sizeof(COMPLEX));
+
+     if (v == NULL) {
+          bots_message("Error: Out of memory\n");
+          exit(101);
+     }
+     bots_first_touch(n, sizeof(COMPLEX), omp_get_max_threads(), clear_range, v);
+     return v;
+}
+
+void fft_init_input(int n, COMPLEX *in)
+{
+     bots_first_touch(n, sizeof(COMPLEX), omp_get_max_threads(), fill_input_range, in);
+}
+
 /*
  * user interface for fft_aux
  */
@@ -150,6 +150,12 @@ static int lay_down(int id, ibrd board, struct cell *cells) {
 static void read_inputs() {
   int i, j, n;
 
+  /* every repetition reads the input again; drop the cells of the last one */
+  if (gcells != NULL) {
+      for (i = 1; i < N + 1; i++) free(gcells[i].alt);
+      free(gcells);
+  }
+
   read_integer(inputFile,n);
   N = n;
   
@@ -602,6 +608,7 @@ void floorplan_init (char *filename)
     
     /* read input file and initialize global minimum area */
     read_inputs();
+    fclose(inputFile);
     MIN_AREA = ROWS * COLS;
     
     /* initialize board is empty */
@@ -174,6 +174,40 @@ void allocate_village( struct Village **capital, struct Village *back,
    }
 }
 /**********************************************************************/
+static void free_patients(struct Patient *list)
+{
+   struct Patient *p;
+
+   while (list != NULL)
+   {
+      p = list;
+      list = list->forward;
+      free(p);
+   }
+}
+/**********************************************************************/
+void free_village(struct Village *village)
+{
+   struct Village *vlist, *vnext;
+
+   if (village == NULL) return;
+   vlist = village->forward;
+   while (vlist)
+   {
+      vnext = vlist->next;
+      free_village(vlist);
+      vlist = vnext;
+   }
+   /* every patient is in exactly one list of one village */
+   free_patients(village->population);
+   free_patients(village->hosp.waiting);
+   free_patients(village->hosp.assess);
+   free_patients(village->hosp.inside);
+   free_patients(village->hosp.realloc);
+   omp_destroy_lock(&village->hosp.realloc_lock);
+   free(village);
+}
+/**********************************************************************/
 struct Results get_results(struct Village *village)
 {
    struct Village *vlist;
@@ -93,6 +93,7 @@ struct Results get_results(struct Village *village);
 
 void read_input_data(char *filename);
 void allocate_village( struct Village **capital, struct Village *back, struct Village *next, int level, int32_t vid);
+void free_village(struct Village *village);
 void sim_village_main_par(struct Village *top);
 
 void sim_village_par(struct Village *village);
@@ -370,13 +370,80 @@ void nqueens(int n, int j, char *a, int depth)
 
 #endif
 
+/*
+ * Mirror symmetry: the reflection of a solution has its first queen on
+ * column n-1-c, so only the first half of row 0 is explored and counted
+ * twice, plus the middle column once when n is odd. Enabled with
+ * BOTS_NQUEENS_SYMMETRY=1.
+ */
+static int symmetry_enabled()
+{
+	char *sym_a = getenv("BOTS_NQUEENS_SYMMETRY");
+	return sym_a && atoi(sym_a) > 0;
+}
+
+/* number of solutions with the first queen on a column of [lo, hi) */
+static int nqueens_columns(int size, int lo, int hi)
+{
+	int count = 0;
+
+	#pragma omp parallel
+	{
+#ifdef FORCE_TIED_TASKS
+		mycount = 0;
+#endif
+		#pragma omp single
+		{
+			int i;
+#ifndef FORCE_TIED_TASKS
+			int *csols = (int *)alloca((hi - lo)*sizeof(int));
+			memset(csols,0,(hi - lo)*sizeof(int));
+#endif
+
+			for (i = lo; i < hi; i++) {
+				#pragma omp task untied
+				{
+					char * b = (char *)alloca(size * sizeof(char));
+					b[0] = (char) i;
+#ifndef FORCE_TIED_TASKS
+					nqueens(size, 1, b, &csols[i - lo], 1);
+#else
+					nqueens(size, 1, b, 1);
+#endif
+				}
+			}
+			#pragma omp taskwait
+#ifndef FORCE_TIED_TASKS
+			for (i = 0; i < hi - lo; i++) count += csols[i];
+#endif
+		}
+#ifdef FORCE_TIED_TASKS
+		#pragma omp atomic
+			count += mycount;
+#endif
+	}
+	return count;
+}
+
 void find_queens (int size)
 {
+	int symmetry = symmetry_enabled();
+
 	total_count=0;
 
-        bots_message("Computing N-Queens algorithm (n=%d) ", size);
+        bots_message("Computing N-Queens algorithm (n=%d%s) ", size, symmetry ? ", mirror symmetry" : "");
+	if (symmetry) {
+		total_count = 2 * nqueens_columns(size, 0, size / 2);
+		if (size % 2) total_count += nqueens_columns(size, size / 2, size / 2 + 1);
+		bots_message(" completed!\n");
+		return;
+	}
 	#pragma omp parallel
 	{
+#ifdef FORCE_TIED_TASKS
+		/* the threadprivate counts of the previous repetition */
+		mycount = 0;
+#endif
 		#pragma omp single
 		{
 			char *a;
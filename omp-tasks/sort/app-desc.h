@@ -55,11 +55,12 @@ void sort ( void );
 
 void sort_par (void);
 void sort_init (void);
+void sort_reset (void);
 int sort_verify (void);
 
 #define BOTS_APP_INIT sort_init()
 
-#define KERNEL_INIT
+#define KERNEL_INIT sort_reset()
 #define KERNEL_CALL sort_par()
 #define KERNEL_CHECK sort_verify()
 
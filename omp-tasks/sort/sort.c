@@ -412,17 +412,28 @@ void scramble_array( ELM *array )
      }
 }
 
-void fill_array( ELM *array )
+static void fill_range( void *arg, long begin, long end )
 {
-     unsigned long i;
+     ELM *array = (ELM *) arg;
+     long i;
 
-     my_srand(1);
-     /* first, fill with integers 1..size */
-     for (i = 0; i < bots_arg_size; ++i) {
+     for (i = begin; i < end; ++i) {
 	  array[i] = i;
      }
 }
 
+static void clear_range( void *arg, long begin, long end )
+{
+     memset((ELM *) arg + begin, 0, (end - begin) * sizeof(ELM));
+}
+
+void fill_array( ELM *array )
+{
+     my_srand(1);
+     /* first, fill with integers 1..size (pages are first touched in parallel) */
+     bots_first_touch(bots_arg_size, sizeof(ELM), omp_get_max_threads(), fill_range, array);
+}
+
 void sort_init ( void )
 {
      /* Checking arguments */
@@ -460,6 +471,12 @@ void sort_init ( void )
 
      array = (ELM *) malloc(bots_arg_size * sizeof(ELM));
      tmp = (ELM *) malloc(bots_arg_size * sizeof(ELM));
+     bots_first_touch(bots_arg_size, sizeof(ELM), omp_get_max_threads(), clear_range, tmp);
+}
+
+/* (Re)generates the input so every repetition sorts the same permutation */
+void sort_reset ( void )
+{
      fill_array(array);
      scramble_array(array);
 }
@@ -24,6 +24,7 @@
 #include <string.h>
 #include <math.h>
 #include <libgen.h>
+#include <omp.h>
 #include "bots.h"
 #include "sparselu.h"
 
@@ -61,16 +62,64 @@ int checkmat (float *M, float *N)
    }
    return TRUE;
 }
+/***********************************************************************
+ * genmat_range: initializes the blocks [begin, end) of the matrix
+ **********************************************************************/
+typedef struct {
+   float **blocks;
+   long block_elems;
+} genmat_blocks_t;
+
+/* the generator is x' = 3125 x mod 65536, so it can skip ahead */
+static int genmat_skip(int init_val, long steps)
+{
+   long mult = 3125, val = init_val;
+
+   while (steps > 0) {
+      if (steps & 1) val = (mult * val) % 65536;
+      mult = (mult * mult) % 65536;
+      steps >>= 1;
+   }
+   return (int) val;
+}
+
+static void genmat_range(void *arg, long begin, long end)
+{
+   genmat_blocks_t *gen = (genmat_blocks_t *) arg;
+   int init_val;
+   long k, e;
+   float *p;
+
+   /* continue the sequence where the previous blocks left it */
+   init_val = genmat_skip(1325, begin * gen->block_elems);
+   for (k = begin; k < end; k++)
+   {
+      p = gen->blocks[k];
+      for (e = 0; e < gen->block_elems; e++)
+      {
+         init_val = (3125 * init_val) % 65536;
+         (*p) = (float)((init_val - 32768.0) / 16384.0);
+         p++;
+      }
+   }
+}
 /***********************************************************************
  * genmat: 
  **********************************************************************/
 void genmat (float *M[])
 {
-   int null_entry, init_val, i, j, ii, jj;
-   float *p;
+   int null_entry, ii, jj;
+   long nblocks = 0;
+   genmat_blocks_t gen;
    int a=0,b=0;
 
-   init_val = 1325;
+   gen.block_elems = (long) bots_arg_size_1 * bots_arg_size_1;
+   gen.blocks = (float **) malloc(bots_arg_size*bots_arg_size*sizeof(float *));
+   if (gen.blocks == NULL)
+   {
+      bots_message("Error: Out of memory\n");
+      exit(101);
+   }
 
    /* generating the structure */
    for (ii=0; ii < bots_arg_size; ii++)
@@ -95,17 +144,7 @@ void genmat (float *M[])
                bots_message("Error: Out of memory\n");
                exit(101);
             }
-            /* initializing matrix */
-            p = M[ii*bots_arg_size+jj];
-            for (i = 0; i < bots_arg_size_1; i++) 
-            {
-               for (j = 0; j < bots_arg_size_1; j++)
-               {
-	            init_val = (3125 * init_val) % 65536;
-      	            (*p) = (float)((init_val - 32768.0) / 16384.0);
-                    p++;
-               }
-            }
+            gen.blocks[nblocks++] = M[ii*bots_arg_size+jj];
          }
          else
          {
@@ -114,6 +153,9 @@ void genmat (float *M[])
          }
       }
    }
+   /* initializing the blocks in parallel, which also places their pages */
+   bots_first_touch(nblocks, gen.block_elems * sizeof(float), omp_get_max_threads(), genmat_range, &gen);
+   free(gen.blocks);
    bots_debug("allo = %d, no = %d, total = %d, factor = %f\n",a,b,a+b,(float)((float)a/(float)(a+b)));
 }
 /***********************************************************************
@@ -208,8 +250,20 @@ void fwd(float *diag, float *col)
             col[i*bots_arg_size_1+j] = col[i*bots_arg_size_1+j] - diag[i*bots_arg_size_1+k]*col[k*bots_arg_size_1+j];
 }
 
+/* frees a matrix of sparselu_init, with the blocks filled in by the factorization */
+static void free_matrix(float **M)
+{
+   int ii;
+
+   for (ii = 0; ii < bots_arg_size*bots_arg_size; ii++)
+      free(M[ii]);
+   free(M);
+}
+
 void sparselu_init (float ***pBENCH, char *pass)
 {
+   /* a repetition replaces the matrix of the one before */
+   if (*pBENCH != NULL) free_matrix(*pBENCH);
    *pBENCH = (float **) malloc(bots_arg_size*bots_arg_size*sizeof(float *));
    genmat(*pBENCH);
    print_structure(pass, *pBENCH);
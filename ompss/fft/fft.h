@@ -50,6 +50,8 @@ void fft_aux_seq(int n, COMPLEX * in, COMPLEX * out, int *factors, COMPLEX * W,
 void fft(int n, COMPLEX * in, COMPLEX * out);
 void fft_seq(int n, COMPLEX * in, COMPLEX * out);
 int test_correctness(int n, COMPLEX *out1, COMPLEX *out2);
+COMPLEX *fft_alloc(int n);
+void fft_init_input(int n, COMPLEX *in);
 
 #endif
 
@@ -34,10 +34,11 @@
 #define BOTS_CUTOFF_DEF_VALUE 2
 
 #define BOTS_APP_INIT \
-   struct Village *top;\
+   struct Village *top = NULL;\
    read_input_data(bots_arg_file);
 
 #define KERNEL_INIT \
+   free_village(top); \
    allocate_village(&top, NULL, NULL, sim_level, 0);
 
 #define KERNEL_CALL sim_village_main_par(top);
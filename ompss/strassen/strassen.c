@@ -37,6 +37,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "app-desc.h"
 #include "bots.h"
 #include "strassen.h"
@@ -1225,6 +1226,7 @@ void init_matrix(int n, REAL *A, int an)
 {
      int i, j;
 
+     /* rand() is sequential, the pages were placed by alloc_matrix */
      for (i = 0; i < n; ++i)
 	  for (j = 0; j < n; ++j) 
 	       ELEM(A, an, i, j) = ((double) rand()) / (double) RAND_MAX; 
@@ -1256,12 +1258,22 @@ int compare_matrix(int n, REAL *A, int an, REAL *B, int bn)
      return BOTS_RESULT_SUCCESSFUL;
 }
 	       
+static void
+clear_matrix_range(void *arg, long begin, long end)
+{
+     memset((REAL *) arg + begin, 0, (end - begin) * sizeof(REAL));
+}
+
 /*
  * Allocate a matrix of side n (therefore n^2 elements)
  */
 REAL *alloc_matrix(int n) 
 {
-     return malloc(n * n * sizeof(REAL));
+     REAL *A = (REAL *)malloc(n * n * sizeof(REAL));
+
+     /* place the pages next to the threads that will use them */
+     bots_first_touch((long) n * n, sizeof(REAL), omp_get_max_threads(), clear_matrix_range, A);
+     return A;
 }
 
 void strassen_main_par(REAL *A, REAL *B, REAL *C, int n)
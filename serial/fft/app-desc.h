@@ -32,11 +32,11 @@
 void fft(int n, COMPLEX * in, COMPLEX * out);
 
 #define BOTS_APP_INIT int i;\
-     COMPLEX *in, *out1;\
+     COMPLEX *in, *out1=NULL;\
      in = (COMPLEX *)malloc(bots_arg_size * sizeof(COMPLEX));\
 
 #define KERNEL_INIT\
-     out1 = (COMPLEX *)malloc(bots_arg_size * sizeof(COMPLEX));\
+     if (out1 == NULL) out1 = (COMPLEX *)malloc(bots_arg_size * sizeof(COMPLEX));\
      for (i = 0; i < bots_arg_size; ++i) {\
           c_re(in[i]) = 1.0;\
           c_im(in[i]) = 1.0;\
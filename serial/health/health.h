@@ -95,6 +95,7 @@ extern int sim_level;
 
 void read_input_data(char *filename);
 void allocate_village( struct Village **capital, struct Village *back, struct Village *next, int level, int32_t vid);
+void free_village(struct Village *village);
 void sim_village_main(struct Village *top);
 
 int check_village(struct Village *top);
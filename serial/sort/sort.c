@@ -447,7 +447,11 @@ void sort_init ( void )
 
      array = (ELM *) malloc(bots_arg_size * sizeof(ELM));
      tmp = (ELM *) malloc(bots_arg_size * sizeof(ELM));
+}
 
+/* (Re)generates the input so every repetition sorts the same permutation */
+void sort_reset ( void )
+{
      fill_array();
      scramble_array();
 }
@@ -32,7 +32,7 @@
 #define BOTS_APP_DEF_ARG_SIZE_1 100
 #define BOTS_APP_DESC_ARG_SIZE_1 "Submatrix Size"
 
-#define BOTS_APP_INIT float **SEQ;
+#define BOTS_APP_INIT float **SEQ = NULL;
 
 void sparselu_init(float ***pM, char *pass);
 void sparselu_fini(float **M, char *pass);
@@ -195,8 +195,20 @@ void fwd(float *diag, float *col)
             col[i*bots_arg_size_1+j] = col[i*bots_arg_size_1+j] - diag[i*bots_arg_size_1+k]*col[k*bots_arg_size_1+j];
 }
 
+/* frees a matrix of sparselu_init, with the blocks filled in by the factorization */
+static void free_matrix(float **M)
+{
+  int ii;
+
+  for (ii = 0; ii < bots_arg_size*bots_arg_size; ii++)
+    free(M[ii]);
+  free(M);
+}
+
 void sparselu_init (float ***pBENCH, char *pass)
 {
+  /* a repetition replaces the matrix of the one before */
+  if (*pBENCH != NULL) free_matrix(*pBENCH);
   *pBENCH = (float **) malloc(bots_arg_size*bots_arg_size*sizeof(float *));
   genmat(*pBENCH);
   print_structure(pass, *pBENCH);
@@ -1,76 +1,134 @@
 #include "arena.h"
 #include "bots.h"
 
+#include <algorithm>
 #include <cstdlib>
-#include <sched.h>
 #include <sys/sysinfo.h>
 
-/* This observer won't work so well if an arena is reused */
+/* Binds every thread entering the arena to the place of its slot */
 class pinning_observer : public oneapi::tbb::task_scheduler_observer {
-	const unsigned nprocs;
-	const unsigned shift = 0;
-	unsigned counter = 0;
+	const int nthreads;
 public:
-	pinning_observer(oneapi::tbb::task_arena &a, bool cores_only = false)
-		: oneapi::tbb::task_scheduler_observer(a),
-		shift(cores_only ? 1 : 0), nprocs(get_nprocs())
+	pinning_observer(oneapi::tbb::task_arena &a, int nthreads)
+		: oneapi::tbb::task_scheduler_observer(a), nthreads(nthreads)
 	{
 		observe(true);
 	}
 	void on_scheduler_entry(bool worker) override {
-		cpu_set_t *mask = CPU_ALLOC(nprocs);
-		auto mask_size = CPU_ALLOC_SIZE(nprocs);
-		int cpu_number = (counter++ << shift) % nprocs;
-		CPU_ZERO_S(mask_size, mask);
-		CPU_SET_S(cpu_number, mask_size, mask);
-		if (sched_setaffinity(0, mask_size, mask)) {
-			perror("sched_setaffinity");
-			exit(EXIT_FAILURE);
-		}
-		bots_debug("Scheduled a thread on CPU %d\n", cpu_number);
+		int slot = oneapi::tbb::this_task_arena::current_thread_index();
+		int place = bots_bind_thread(slot, nthreads);
+		(void) place; /* only printed in debug builds */
+		bots_debug("Scheduled thread %d on place %d\n", slot, place);
 	}
 	void on_scheduler_exit(bool worker) override {
 		bots_debug("Scheduler exited (worker = %d)\n", worker);
 	}
 };
 
+/* Keeps the threads of a node arena on the CPUs of its node */
+class node_observer : public oneapi::tbb::task_scheduler_observer {
+	const int node;
+public:
+	node_observer(oneapi::tbb::task_arena &a, int node)
+		: oneapi::tbb::task_scheduler_observer(a), node(node)
+	{
+		observe(true);
+	}
+	void on_scheduler_entry(bool worker) override {
+		bots_bind_to_node(node);
+	}
+};
+
 oneapi::tbb::task_arena *arenaptr;
 oneapi::tbb::task_scheduler_observer *observerptr;
+std::vector<oneapi::tbb::task_arena *> numa_arenas;
+static std::vector<oneapi::tbb::task_scheduler_observer *> numa_observers;
+task_counter_t task_counts(0ULL);
 
-void
-init_arenaptr()
+extern "C" int
+arena_max_concurrency()
 {
-	int default_conc = get_nprocs();
-
-	char *places_a = std::getenv("OMP_PLACES");
-	bool cores_only = false;
-	if (places_a == NULL || places_a[0] == 't') { /* threads */
-		/* leave the default */
-	} else { /* assume cores otherwise */
-		cores_only = true;
-		default_conc >>= 1;
-	}
+	/* one thread per core, or per available CPU otherwise */
+	int default_conc = bots_places_are_cores() ? bots_get_num_places() : get_nprocs();
+
+	/* a scalability sweep overrides the environment */
+	if (bots_num_threads > 0)
+		return bots_num_threads;
 
 	char *num_threads_a = std::getenv("OMP_NUM_THREADS");
-	int max_concurrency;
 	if (num_threads_a) {
 		int i = std::atoi(num_threads_a);
 		if (i < 1)
 			i = 1;
-		max_concurrency = i;
-	} else {
-		max_concurrency = default_conc;
+		return i;
+	}
+	return default_conc;
+}
+
+static bool
+numa_arenas_enabled()
+{
+	char *numa_a = std::getenv("BOTS_NUMA_ARENAS");
+	return numa_a && std::atoi(numa_a) > 0 && bots_get_num_nodes() > 1;
+}
+
+/* Splits the threads among the nodes. oneTBB constraints are used when it
+ * knows the node (tbbbind loaded), an observer binds the threads otherwise. */
+static void
+init_numa_arenas(int max_concurrency)
+{
+	int nodes = bots_get_num_nodes();
+	std::vector<oneapi::tbb::numa_node_id> tbb_nodes = oneapi::tbb::info::numa_nodes();
+
+	for (int node = 0; node < nodes; node++) {
+		int concurrency = max_concurrency / nodes + (node < max_concurrency % nodes);
+		oneapi::tbb::numa_node_id id = bots_get_node_id(node);
+		/* the master only stays in the arena of node 0; the others get all
+		 * their slots for workers, or they would run one thread short */
+		unsigned reserved = node == 0 ? 1 : 0;
+		oneapi::tbb::task_arena *arena;
+
+		if (concurrency < 1)
+			concurrency = 1;
+		if (std::find(tbb_nodes.begin(), tbb_nodes.end(), id) != tbb_nodes.end()) {
+			arena = new oneapi::tbb::task_arena(
+				oneapi::tbb::task_arena::constraints(id, concurrency), reserved);
+			numa_observers.push_back(nullptr);
+		} else {
+			arena = new oneapi::tbb::task_arena(concurrency, reserved);
+			numa_observers.push_back(new node_observer(*arena, node));
+		}
+		bots_debug("NUMA arena %d: node %d, %d threads\n", node, id, concurrency);
+		numa_arenas.push_back(arena);
 	}
+	arenaptr = numa_arenas[0];
+	observerptr = new oneapi::tbb::task_scheduler_observer(*arenaptr);
+}
 
+int
+numa_arena_of(const void *data)
+{
+	int node = bots_get_address_node(data);
+	return node < (int) numa_arenas.size() ? node : -1;
+}
+
+void
+init_arenaptr()
+{
+	int max_concurrency = arena_max_concurrency();
+
+	task_counts.clear();
+	if (numa_arenas_enabled()) {
+		init_numa_arenas(max_concurrency);
+		return;
+	}
 	arenaptr = new oneapi::tbb::task_arena(max_concurrency);
+	numa_arenas.assign(1, arenaptr);
 
-	char *proc_bind_a = std::getenv("OMP_PROC_BIND");
-	oneapi::tbb::task_scheduler_observer *observer;
-	if (proc_bind_a && proc_bind_a[0] == 'c') { /* close */
+	if (bots_get_thread_place(0, max_concurrency) != -1) {
 		bots_debug("Constructed pinning observer\n");
-		observerptr = new pinning_observer(*arenaptr, cores_only);
-	} else { /* ignore other settings */
-		/* Don't care */
+		observerptr = new pinning_observer(*arenaptr, max_concurrency);
+	} else { /* OMP_PROC_BIND unset or false */
 		bots_debug("default observer\n");
 		observerptr = new oneapi::tbb::task_scheduler_observer(*arenaptr);
 	}
@@ -80,6 +138,13 @@ void
 fini_arenaptr()
 {
 	bots_debug("Calling cleanup code\n");
+	bots_number_of_tasks = task_counts.combine(std::plus<unsigned long long>());
 	delete observerptr;
-	delete arenaptr;
+	for (auto observer : numa_observers)
+		delete observer;
+	numa_observers.clear();
+	/* arenaptr is numa_arenas[0] */
+	for (auto arena : numa_arenas)
+		delete arena;
+	numa_arenas.clear();
 }
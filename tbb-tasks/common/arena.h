@@ -3,12 +3,21 @@
  * Call init_arenaptr(), use arenaptr->execute(...) to run parallel code, and
  * finally call fini_arenaptr().
  *
- * Assumes CPUs 2n and 2n+1 are siblings (forall n : N < nprocs / 2).
- * This can * be verified by checking the output following command: */
-//	sort -nu /sys/devices/system/cpu/cpu*/topology/thread_siblings_list
+ * The places (OMP_PLACES=threads|cores|sockets|numa_domains) and the binding
+ * policy (OMP_PROC_BIND=close|spread|primary) are taken from the sysfs
+ * topology by bots_topology.c, so threads end up on the same CPUs as with
+ * the OpenMP versions.
+ *
+ * With BOTS_NUMA_ARENAS=1 (and more than one NUMA node) there is one arena per
+ * node, each with its share of the threads, and arenaptr is the first one.
+ * Top-level subproblems are sent to the arena nearest their data with a
+ * numa_task_group. */
 
 #pragma once
 
+#include <memory>
+#include <utility>
+#include <vector>
 #include <oneapi/tbb.h>
 
 /* These are global, but shouldn't be constructed until init_queens */
@@ -17,3 +26,63 @@ extern oneapi::tbb::task_scheduler_observer *observerptr;
 
 void init_arenaptr();
 void fini_arenaptr();
+
+/* Number of threads the arena is (or will be) created with */
+extern "C" int arena_max_concurrency();
+
+/* Per-thread (cache-line padded) counters of spawned tasks. They are
+ * cleared by init_arenaptr() and combined into bots_number_of_tasks by
+ * fini_arenaptr(). */
+typedef oneapi::tbb::enumerable_thread_specific<unsigned long long,
+	oneapi::tbb::cache_aligned_allocator<unsigned long long>,
+	oneapi::tbb::ets_key_per_instance> task_counter_t;
+extern task_counter_t task_counts;
+
+/* A task_group that counts every task it runs */
+class counting_task_group : public oneapi::tbb::task_group {
+public:
+	template <typename F>
+	void run(F &&f) {
+		++task_counts.local();
+		oneapi::tbb::task_group::run(std::forward<F>(f));
+	}
+};
+
+/* One arena per NUMA node when enabled, otherwise only arenaptr */
+extern std::vector<oneapi::tbb::task_arena *> numa_arenas;
+
+/* Arena of the node holding the page at data, -1 when unknown */
+int numa_arena_of(const void *data);
+
+/* A task_group that runs every task in the arena nearest its data. When not
+ * spreading (e.g. below the top level) it is a plain counting_task_group. */
+class numa_task_group {
+	const bool spread;
+	unsigned next = 0;
+	std::unique_ptr<counting_task_group[]> groups;
+public:
+	explicit numa_task_group(bool top_level = true)
+		: spread(top_level && numa_arenas.size() > 1),
+		groups(new counting_task_group[spread ? numa_arenas.size() : 1]) {}
+
+	template <typename F>
+	void run(const void *data, F &&f) {
+		if (!spread) {
+			groups[0].run(std::forward<F>(f));
+			return;
+		}
+		int i = numa_arena_of(data);
+		if (i < 0) /* not placed yet, balance the nodes */
+			i = next++ % numa_arenas.size();
+		numa_arenas[i]->execute([&] { groups[i].run(std::forward<F>(f)); });
+	}
+
+	void wait() {
+		if (!spread) {
+			groups[0].wait();
+			return;
+		}
+		for (size_t i = 0; i < numa_arenas.size(); i++)
+			numa_arenas[i]->execute([&] { groups[i].wait(); });
+	}
+};
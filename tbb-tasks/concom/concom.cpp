@@ -0,0 +1,303 @@
+/**********************************************************************************************/
+/*  This program is part of the Barcelona OpenMP Tasks Suite                                  */
+/*  Copyright (C) 2009 Barcelona Supercomputing Center - Centro Nacional de Supercomputacion  */
+/*  Copyright (C) 2009 Universitat Politecnica de Catalunya                                   */
+/*                                                                                            */
+/*  This program is free software; you can redistribute it and/or modify                      */
+/*  it under the terms of the GNU General Public License as published by                      */
+/*  the Free Software Foundation; either version 2 of the License, or                         */
+/*  (at your option) any later version.                                                       */
+/*                                                                                            */
+/*  This program is distributed in the hope that it will be useful,                           */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of                            */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                             */
+/*  GNU General Public License for more details.                                              */
+/*                                                                                            */
+/*  You should have received a copy of the GNU General Public License                         */
+/*  along with this program; if not, write to the Free Software                               */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA            */
+/**********************************************************************************************/
+
+/*
+ * oneTBB version. Instead of a DFS taking a lock on every visited node,
+ * the components are built by a concurrent union-find over the links.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <atomic>
+#include <algorithm>
+#include <functional>
+#include <oneapi/tbb.h>
+#include "bots.h"
+#include "concom.h"
+#include "arena.h"
+
+// bots_arg_size == Number of nodes
+// bots_arg_size_1 == Maximum number of neighbors per node
+// bots_arg_size_2 == Number of links in the entire graph
+
+long *offsets;
+int *adjacency, *visited, *components;
+
+/* The graph is stored in CSR form: the neighbors of node i are
+ * adjacency[offsets[i]] .. adjacency[offsets[i+1]-1], sorted */
+
+static int *stack;
+
+/* union-find forest: every node points to a node of smaller or equal
+ * index, so the root of a component is its smallest node */
+static std::atomic<int> *parent;
+
+/* set of the links already generated (open addressing on the node pair) */
+static unsigned long long *link_set;
+static unsigned long link_mask;
+
+// Checks to see if two nodes can be linked, and records the link if so
+static int new_link(const int *degree, int N1, int N2) {
+    unsigned long long key;
+    unsigned long h;
+
+    if (N1 == N2) return (0);
+    if (degree[N1] >= bots_arg_size_1) return (0);
+    if (degree[N2] >= bots_arg_size_1) return (0);
+
+    /* +1 so that 0 marks an empty slot */
+    key = N1 < N2 ? ((unsigned long long) N1 << 32 | N2) : ((unsigned long long) N2 << 32 | N1);
+    key++;
+    h = (unsigned long) ((key * 0x9E3779B97F4A7C15ULL) >> 32) & link_mask;
+    while (link_set[h] != 0) {
+        if (link_set[h] == key) return (0);
+        h = (h + 1) & link_mask;
+    }
+    link_set[h] = key;
+
+    return (1);
+}
+// Builds the CSR arrays from the edge list in parallel
+static void build_csr(int (*edges)[2], long nedges, const int *degree) {
+   using namespace oneapi::tbb;
+   std::atomic<int> *cursor = new std::atomic<int>[bots_arg_size];
+
+   offsets = (long *) malloc((bots_arg_size + 1) * sizeof(long));
+   adjacency = (int *) malloc((2 * nedges + 1) * sizeof(int));
+   if (offsets == NULL || adjacency == NULL) {
+      bots_message("Error: Out of memory\n");
+      exit(101);
+   }
+
+   task_arena arena(arena_max_concurrency());
+   arena.execute([&] {
+      /* offsets: prefix sum of the degrees */
+      parallel_scan(blocked_range<int>(0, bots_arg_size), 0L,
+         [&](const blocked_range<int> &r, long sum, bool final) {
+            for (int i = r.begin(); i != r.end(); i++) {
+               if (final) {
+                  offsets[i] = sum;
+                  cursor[i].store(0, std::memory_order_relaxed);
+               }
+               sum += degree[i];
+            }
+            return sum;
+         }, std::plus<long>());
+
+      /* scatter both ends of every link */
+      parallel_for(blocked_range<long>(0, nedges), [&](const blocked_range<long> &r) {
+         for (long e = r.begin(); e != r.end(); e++) {
+            int N1 = edges[e][0], N2 = edges[e][1];
+            adjacency[offsets[N1] + cursor[N1]++] = N2;
+            adjacency[offsets[N2] + cursor[N2]++] = N1;
+         }
+      });
+
+      /* the scatter order depends on the schedule; sort the lists */
+      parallel_for(blocked_range<int>(0, bots_arg_size), [&](const blocked_range<int> &r) {
+         for (int i = r.begin(); i != r.end(); i++)
+            std::sort(adjacency + offsets[i], adjacency + offsets[i] + degree[i]);
+      });
+   });
+   offsets[bots_arg_size] = 2 * nedges;
+   delete[] cursor;
+}
+// Allocates and creates a graph with random links between nodes
+// also allocates visited and components vectors
+extern "C" void initialize() {
+   int i, N1, N2;
+   int (*edges)[2];
+   long nedges = 0;
+   unsigned long slots;
+   double RN;
+   int *degree = (int *) calloc(bots_arg_size, sizeof(int));
+   
+   edges = (int (*)[2]) malloc(bots_arg_size_2 * sizeof(*edges));
+   for (slots = 1024; slots < 2 * (unsigned long) bots_arg_size_2; slots *= 2);
+   link_set = (unsigned long long *) calloc(slots, sizeof(unsigned long long));
+   link_mask = slots - 1;
+   visited = (int *) malloc(bots_arg_size * sizeof(int)); 
+   components = (int *) malloc(bots_arg_size * sizeof(int)); 
+   stack = (int *) malloc(bots_arg_size * sizeof(int));
+   parent = new std::atomic<int>[bots_arg_size];
+   if (degree == NULL || edges == NULL || link_set == NULL ||
+       visited == NULL || components == NULL || stack == NULL) {
+      bots_message("Error: Out of memory\n");
+      exit(101);
+   }
+   /* for each link, generate end nodes and link */
+   for (i = 0; i < bots_arg_size_2; i++)
+   {
+      RN = rand() / (double) RAND_MAX;
+      N1 = (int) ((bots_arg_size-1) * RN);
+      RN = rand() / (double) RAND_MAX;
+      N2 = (int) ((bots_arg_size-1) * RN);
+      if (new_link(degree, N1, N2)) {
+         edges[nedges][0] = N1;
+         edges[nedges][1] = N2;
+         degree[N1] += 1;
+         degree[N2] += 1;
+         nedges++;
+      }   
+   }
+   free(link_set);
+
+   build_csr(edges, nedges, degree);
+   free(edges);
+   free(degree);
+}
+// Writes the number of CCs
+extern "C" void write_outputs(int n, int cc) {
+  int i;
+
+  printf("Graph %d, Number of components %d\n", n, cc);
+
+  if (bots_verbose_mode)
+     for (i = 0; i < cc; i++)
+         printf("Component %d       Size: %d\n", i, components[i]);
+}
+// Root of x, halving the path on the way: each visited node is pointed
+// to its grandparent. A failed CAS only means someone else shortened it.
+static int find(int x)
+{
+   int p, gp;
+
+   while ((p = parent[x].load(std::memory_order_relaxed)) != x) {
+      gp = parent[p].load(std::memory_order_relaxed);
+      if (p != gp) parent[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+      x = gp;
+   }
+   return x;
+}
+// Joins the components of a and b, linking the larger root under the
+// smaller one (union by index), which keeps the forest acyclic
+static void unite(int a, int b)
+{
+   for (;;) {
+      a = find(a);
+      b = find(b);
+      if (a == b) return;
+      if (a < b) { int t = a; a = b; b = t; }
+      /* fails only if a stopped being a root meanwhile */
+      if (parent[a].compare_exchange_strong(a, b, std::memory_order_relaxed)) return;
+   }
+}
+// Marks a node and all its neighbors as part of the CC, with an explicit
+// stack so that large components do not overflow the call stack
+extern "C" void CC_seq (int i, int cc)
+{
+   long j;
+   int n, top = 0;
+   /* if node has not been visited */
+   if (visited[i] != 0) return;
+   visited[i] = 1;
+   stack[top++] = i;
+   while (top > 0) {
+      i = stack[--top];
+      /* add node to current component */
+      bots_debug("Adding node %d to component %d\n", i, cc);
+      components[cc]++;
+      /* add each unvisited neighbor to the current component */
+      for (j = offsets[i]; j < offsets[i+1]; j++)
+      {
+         n = adjacency[j];
+         if (visited[n] == 0) {
+            visited[n] = 1;
+            stack[top++] = n;
+         }
+      }
+   }
+}
+extern "C" void cc_init()
+{
+    int i;
+   /* initialize global data structures */      
+   for (i = 0; i < bots_arg_size; i++)
+   {
+      visited[i] = 0;
+      components[i] = 0;
+   }
+}
+extern "C" void cc_par(int *cc)
+{
+   using namespace oneapi::tbb;
+
+   arenaptr->execute([&] {
+      parallel_for(blocked_range<int>(0, bots_arg_size), [](const blocked_range<int> &r) {
+         ++task_counts.local();
+         for (int i = r.begin(); i != r.end(); i++)
+            parent[i].store(i, std::memory_order_relaxed);
+      });
+      /* every link once, from its smaller end */
+      parallel_for(blocked_range<int>(0, bots_arg_size), [](const blocked_range<int> &r) {
+         ++task_counts.local();
+         for (int i = r.begin(); i != r.end(); i++)
+            for (long j = offsets[i]; j < offsets[i+1]; j++)
+               if (adjacency[j] > i) unite(i, adjacency[j]);
+      });
+      /* every component has exactly one root */
+      *cc = parallel_reduce(blocked_range<int>(0, bots_arg_size), 0,
+         [](const blocked_range<int> &r, int count) {
+            ++task_counts.local();
+            for (int i = r.begin(); i != r.end(); i++)
+               if (parent[i].load(std::memory_order_relaxed) == i) count++;
+            return count;
+         }, std::plus<int>());
+   });
+
+   if (bots_verbose_mode >= BOTS_VERBOSE_DEBUG) {
+      /* roots are the smallest node of their component, so numbering them
+       * in order gives the components the same numbers as the DFS */
+      int i, ncc = 0;
+      for (i = 0; i < bots_arg_size; i++)
+         if (parent[i] == i) visited[i] = ncc++;
+      for (i = 0; i < bots_arg_size; i++)
+         components[visited[find(i)]]++;
+   }
+}
+extern "C" void cc_seq(int *cc)
+{
+   int i;
+   (*cc) = 0;
+   /* for all nodes ... unvisited nodes start a new component */
+   for (i = 0; i < bots_arg_size; i++)
+   {
+      if (visited[i] == 0)
+      {
+         CC_seq(i, *cc);
+         (*cc)++;
+      }
+   }
+}
+extern "C" int cc_check(int ccs, int ccp)
+{
+  if (bots_verbose_mode) fprintf(stdout, "Sequential = %d CC, Parallel =%d CC\n", ccs, ccp);
+  if (ccs == ccp) return BOTS_RESULT_SUCCESSFUL;
+  else return BOTS_RESULT_UNSUCCESSFUL;
+}
+extern "C" void init_par()
+{
+   init_arenaptr();
+}
+extern "C" void fini_par()
+{
+   fini_arenaptr();
+}
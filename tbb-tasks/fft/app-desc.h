@@ -40,17 +40,17 @@ typedef struct {
 #define c_re(c)  ((c).re)
 #define c_im(c)  ((c).im)
 
+COMPLEX *fft_alloc(int n);
+void fft_init_input(int n, COMPLEX *in);
+
 #define BOTS_APP_INIT int i;\
      COMPLEX *in, *out1=NULL, *out2=NULL;\
-     in = (COMPLEX *)malloc(bots_arg_size * sizeof(COMPLEX));\
+     in = fft_alloc(bots_arg_size);\
 
 #define KERNEL_INIT\
      init_par();\
-     out1 = (COMPLEX *)malloc(bots_arg_size * sizeof(COMPLEX));\
-     for (i = 0; i < bots_arg_size; ++i) {\
-          c_re(in[i]) = 1.0;\
-          c_im(in[i]) = 1.0;\
-     }
+     if (out1 == NULL) out1 = fft_alloc(bots_arg_size);\
+     fft_init_input(bots_arg_size, in);
 #define KERNEL_CALL fft(bots_arg_size, in, out1);
 #define KERNEL_FINI fini_par();
 
@@ -58,7 +58,7 @@ compute_w_coefficients(int n, int a, int b, COMPLEX * W)
 		}
 	} else {
 		int ab = (a + b) / 2;
-		oneapi::tbb::task_group g;
+		counting_task_group g;
 		g.run([=] {
 		compute_w_coefficients(n, a, ab, W);
 		});
@@ -141,7 +141,7 @@ unshuffle(int a, int b, COMPLEX * in, COMPLEX * out, int r, int m)
 		}
 	} else {
 		int ab = (a + b) / 2;
-		oneapi::tbb::task_group g;
+		counting_task_group g;
 		g.run([=] {
 		unshuffle(a, ab, in, out, r, m);
 		});
@@ -216,7 +216,7 @@ fft_twiddle_gen1(COMPLEX * in, COMPLEX * out,
 void
 fft_twiddle_gen(int i, int i1, COMPLEX * in, COMPLEX * out, COMPLEX * W, int nW, int nWdn, int r, int m)
 {
-	oneapi::tbb::task_group g;
+	counting_task_group g;
 	if (i == i1 - 1) {
 		g.run([=] {
 		fft_twiddle_gen1(in + i, out + i, W,
@@ -293,7 +293,7 @@ fft_twiddle_2(int a, int b, COMPLEX * in, COMPLEX * out, COMPLEX * W, int nW, in
 		}
 	} else {
 		int ab = (a + b) / 2;
-		oneapi::tbb::task_group g;
+		counting_task_group g;
 		g.run([=] {
 		fft_twiddle_2(a, ab, in, out, W, nW, nWdn, m);
 		});
@@ -352,7 +352,7 @@ fft_unshuffle_2(int a, int b, COMPLEX * in, COMPLEX * out, int m)
 		}
 	} else {
 		int ab = (a + b) / 2;
-		oneapi::tbb::task_group g;
+		counting_task_group g;
 		g.run([=] {
 		fft_unshuffle_2(a, ab, in, out, m);
 		});
@@ -485,7 +485,7 @@ fft_twiddle_4(int a, int b, COMPLEX * in, COMPLEX * out, COMPLEX * W, int nW, in
 		}
 	} else {
 		int ab = (a + b) / 2;
-		oneapi::tbb::task_group g;
+		counting_task_group g;
 		g.run([=] {
 		fft_twiddle_4(a, ab, in, out, W, nW, nWdn, m);
 		});
@@ -582,7 +582,7 @@ fft_unshuffle_4(int a, int b, COMPLEX * in, COMPLEX * out, int m)
 		}
 	} else {
 		int ab = (a + b) / 2;
-		oneapi::tbb::task_group g;
+		counting_task_group g;
 		g.run([=] {
 		fft_unshuffle_4(a, ab, in, out, m);
 		});
@@ -874,7 +874,7 @@ fft_twiddle_8(int a, int b, COMPLEX * in, COMPLEX * out, COMPLEX * W, int nW, in
 		}
 	} else {
 		int ab = (a + b) / 2;
-		oneapi::tbb::task_group g;
+		counting_task_group g;
 		g.run([=] {
 		fft_twiddle_8(a, ab, in, out, W, nW, nWdn, m);
 		});
@@ -1063,7 +1063,7 @@ fft_unshuffle_8(int a, int b, COMPLEX * in, COMPLEX * out, int m)
 		}
 	} else {
 		int ab = (a + b) / 2;
-		oneapi::tbb::task_group g;
+		counting_task_group g;
 		g.run([=] {
 		fft_unshuffle_8(a, ab, in, out, m);
 		});
@@ -1731,7 +1731,7 @@ fft_twiddle_16(int a, int b, COMPLEX * in, COMPLEX * out, COMPLEX * W, int nW, i
 		}
 	} else {
 		int ab = (a + b) / 2;
-		oneapi::tbb::task_group g;
+		counting_task_group g;
 		g.run([=] {
 		fft_twiddle_16(a, ab, in, out, W, nW, nWdn, m);
 		});
@@ -2136,7 +2136,7 @@ fft_unshuffle_16(int a, int b, COMPLEX * in, COMPLEX * out, int m)
 		}
 	} else {
 		int ab = (a + b) / 2;
-		oneapi::tbb::task_group g;
+		counting_task_group g;
 		g.run([=] {
 		fft_unshuffle_16(a, ab, in, out, m);
 		});
@@ -3684,7 +3684,7 @@ fft_twiddle_32(int a, int b, COMPLEX * in, COMPLEX * out, COMPLEX * W, int nW, i
 		}
 	} else {
 		int ab = (a + b) / 2;
-		oneapi::tbb::task_group g;
+		counting_task_group g;
 		g.run([=] {
 		fft_twiddle_32(a, ab, in, out, W, nW, nWdn, m);
 		});
@@ -4585,7 +4585,7 @@ fft_unshuffle_32(int a, int b, COMPLEX * in, COMPLEX * out, int m)
 		}
 	} else {
 		int ab = (a + b) / 2;
-		oneapi::tbb::task_group g;
+		counting_task_group g;
 		g.run([=] {
 		fft_unshuffle_32(a, ab, in, out, m);
 		});
@@ -4727,7 +4727,7 @@ fft_aux(int n, COMPLEX * in, COMPLEX * out, int *factors, COMPLEX * W, int nW)
 	m = n / r;
 
 	if (r < n) {
-		oneapi::tbb::task_group g;
+		counting_task_group g;
 		/* 
 		 * split the DFT of length n into r DFTs of length n/r,  and
 		 * recurse 
@@ -4768,7 +4768,7 @@ fft_aux(int n, COMPLEX * in, COMPLEX * out, int *factors, COMPLEX * W, int nW)
 	 * now multiply by the twiddle factors, and perform m FFTs
 	 * of length r
 	 */
-	oneapi::tbb::task_group g;
+	counting_task_group g;
 	if (r == 2) {
 		g.run([=] {
 		fft_twiddle_2(0, m, in, out, W, nW, nW / n, m);
@@ -4949,6 +4949,44 @@ test_correctness(int n, COMPLEX *out1, COMPLEX *out2)
 	else return BOTS_RESULT_SUCCESSFUL;
 }
 
+static void
+clear_range(void *arg, long begin, long end)
+{
+	memset((COMPLEX *) arg + begin, 0, (end - begin) * sizeof(COMPLEX));
+}
+
+static void
+fill_input_range(void *arg, long begin, long end)
+{
+	COMPLEX *in = (COMPLEX *) arg;
+	long i;
+
+	for (i = begin; i < end; ++i) {
+		c_re(in[i]) = 1.0;
+		c_im(in[i]) = 1.0;
+	}
+}
+
+/* vectors are first touched in parallel to spread their pages */
+extern "C" COMPLEX *
+fft_alloc(int n)
+{
+	COMPLEX *v = (COMPLEX *)malloc(n * sizeof(COMPLEX));
+
+	if (v == NULL) {
+		bots_message("Error: Out of memory\n");
+		exit(101);
+	}
+	bots_first_touch(n, sizeof(COMPLEX), arena_max_concurrency(), clear_range, v);
+	return v;
+}
+
+extern "C" void
+fft_init_input(int n, COMPLEX *in)
+{
+	bots_first_touch(n, sizeof(COMPLEX), arena_max_concurrency(), fill_input_range, in);
+}
+
 extern "C" void
 init_par()
 {
@@ -50,6 +50,8 @@ void fft_aux_seq(int n, COMPLEX * in, COMPLEX * out, int *factors, COMPLEX * W,
 extern "C" void fft(int n, COMPLEX * in, COMPLEX * out);
 extern "C" void fft_seq(int n, COMPLEX * in, COMPLEX * out);
 extern "C" int test_correctness(int n, COMPLEX *out1, COMPLEX *out2);
+extern "C" COMPLEX *fft_alloc(int n);
+extern "C" void fft_init_input(int n, COMPLEX *in);
 extern "C" void init_par();
 extern "C" void fini_par();
 
@@ -46,7 +46,7 @@ long long fib (int n, int d)
 	if (n < 2) return n;
 
 	if ( d < bots_cutoff_value ) {
-		oneapi::tbb::task_group g;
+		counting_task_group g;
 
 		g.run([=, &x] {
 		x = fib(n - 1,d+1);
@@ -72,7 +72,7 @@ long long fib (int n)
 	long long x, y;
 	if (n < 2) return n;
 
-	oneapi::tbb::task_group g;
+	counting_task_group g;
 	g.run([=, &x] {
 	x = fib(n - 1);
 	});
@@ -0,0 +1,43 @@
+/**********************************************************************************************/
+/*  This program is part of the Barcelona OpenMP Tasks Suite                                  */
+/*  Copyright (C) 2009 Barcelona Supercomputing Center - Centro Nacional de Supercomputacion  */
+/*  Copyright (C) 2009 Universitat Politecnica de Catalunya                                   */
+/*                                                                                            */
+/*  This program is free software; you can redistribute it and/or modify                      */
+/*  it under the terms of the GNU General Public License as published by                      */
+/*  the Free Software Foundation; either version 2 of the License, or                         */
+/*  (at your option) any later version.                                                       */
+/*                                                                                            */
+/*  This program is distributed in the hope that it will be useful,                           */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of                            */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                             */
+/*  GNU General Public License for more details.                                              */
+/*                                                                                            */
+/*  You should have received a copy of the GNU General Public License                         */
+/*  along with this program; if not, write to the Free Software                               */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA            */
+/**********************************************************************************************/
+
+#include "tbb-tasks-app.h"
+
+#define BOTS_APP_NAME "Floorplan"
+#define BOTS_APP_PARAMETERS_DESC "%s"
+#define BOTS_APP_PARAMETERS_LIST ,bots_arg_file
+
+#define BOTS_APP_USES_ARG_FILE
+#define BOTS_APP_DESC_ARG_FILE "Cell description file (mandatory)"
+
+#define BOTS_CUTOFF_DEF_VALUE 5
+
+void floorplan_init(char *);
+void floorplan_end (void);
+void compute_floorplan(void);
+int floorplan_verify(void);
+
+#define KERNEL_INIT floorplan_init(bots_arg_file)
+#define KERNEL_CALL compute_floorplan()
+#define KERNEL_FINI floorplan_end()
+
+#define KERNEL_CHECK floorplan_verify()
+
+
@@ -0,0 +1,498 @@
+/**********************************************************************************************/
+/*  This program is part of the Barcelona OpenMP Tasks Suite                                  */
+/*  Copyright (C) 2009 Barcelona Supercomputing Center - Centro Nacional de Supercomputacion  */
+/*  Copyright (C) 2009 Universitat Politecnica de Catalunya                                   */
+/*                                                                                            */
+/*  This program is free software; you can redistribute it and/or modify                      */
+/*  it under the terms of the GNU General Public License as published by                      */
+/*  the Free Software Foundation; either version 2 of the License, or                         */
+/*  (at your option) any later version.                                                       */
+/*                                                                                            */
+/*  This program is distributed in the hope that it will be useful,                           */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of                            */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                             */
+/*  GNU General Public License for more details.                                              */
+/*                                                                                            */
+/*  You should have received a copy of the GNU General Public License                         */
+/*  along with this program; if not, write to the Free Software                               */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA            */
+/**********************************************************************************************/
+
+/* Original code from the Application Kernel Matrix by Cray */
+
+/*
+ * oneTBB version. Every task needs its own copy of the board and of the
+ * cells; instead of a fresh copy on each spawn they live in frames taken
+ * from per-thread free lists and recycled when the task completes.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <atomic>
+#include <oneapi/tbb.h>
+#include "bots.h"
+#include "floorplan.h"
+#include "arena.h"
+
+#define ROWS 64
+#define COLS 64
+#define DMAX 64
+#define max(a, b) ((a > b) ? a : b)
+#define min(a, b) ((a < b) ? a : b)
+
+int solution = -1;
+
+typedef int  coor[2];
+typedef char ibrd[ROWS][COLS];
+typedef char (*pibrd)[COLS];
+
+FILE * inputFile;
+
+struct cell {
+  int   n;
+  coor *alt;
+  int   top;
+  int   bot;
+  int   lhs;
+  int   rhs;
+  int   left;
+  int   above;
+  int   next;
+};
+
+struct cell * gcells;
+
+static std::atomic<int> MIN_AREA;
+static oneapi::tbb::spin_mutex best_lock;   /* guards the best board */
+ibrd BEST_BOARD;
+coor MIN_FOOTPRINT;
+
+int N;
+
+/* compute all possible locations for nw corner for cell */
+static int starts(int id, int shape, coor *NWS, struct cell *cells) {
+  int i, n, top, bot, lhs, rhs;
+  int rows, cols, left, above;
+
+/* size of cell */
+  rows  = cells[id].alt[shape][0];
+  cols  = cells[id].alt[shape][1];
+
+/* the cells to the left and above */
+  left  = cells[id].left;
+  above = cells[id].above;
+
+/* if there is a vertical and horizontal dependence */
+  if ((left >= 0) && (above >= 0)) {
+
+     top = cells[above].bot + 1;
+     lhs = cells[left].rhs + 1;
+     bot = top + rows;
+     rhs = lhs + cols;
+
+/* if footprint of cell touches the cells to the left and above */
+     if ((top <= cells[left].bot) && (bot >= cells[left].top) &&
+         (lhs <= cells[above].rhs) && (rhs >= cells[above].lhs))
+          { n = 1; NWS[0][0] = top; NWS[0][1] = lhs;  }
+     else { n = 0; }
+
+/* if there is only a horizontal dependence */
+   } else if (left >= 0) {
+
+/* highest initial row is top of cell to the left - rows */ 
+     top = max(cells[left].top - rows + 1, 0);
+/* lowest initial row is bottom of cell to the left */
+     bot = min(cells[left].bot, ROWS);
+     n   = bot - top + 1;
+
+     for (i = 0; i < n; i++) {
+         NWS[i][0] = i + top;
+         NWS[i][1] = cells[left].rhs + 1;
+     }
+
+  } else {
+
+/* leftmost initial col is lhs of cell above - cols */
+     lhs = max(cells[above].lhs - cols + 1, 0);
+/* rightmost initial col is rhs of cell above */
+     rhs = min(cells[above].rhs, COLS);
+     n   = rhs - lhs + 1;
+
+     for (i = 0; i < n; i++) {
+         NWS[i][0] = cells[above].bot + 1;
+         NWS[i][1] = i + lhs;
+  }  }
+
+  return (n);
+}
+
+
+
+/* lay the cell down on the board in the rectangular space defined
+   by the cells top, bottom, left, and right edges. If the cell can
+   not be layed down, return 0; else 1.
+*/
+static int lay_down(int id, ibrd board, struct cell *cells) {
+  int  i, j, top, bot, lhs, rhs;
+
+  top = cells[id].top;
+  bot = cells[id].bot;
+  lhs = cells[id].lhs;
+  rhs = cells[id].rhs;
+
+  for (i = top; i <= bot; i++) {
+  for (j = lhs; j <= rhs; j++) {
+      if (board[i][j] == 0) board[i][j] = (char)id;
+      else                  return(0);
+  } }
+
+  return (1);
+}
+
+
+#define read_integer(file,var) \
+  if ( fscanf(file, "%d", &var) == EOF ) {\
+	bots_message(" Bogus input file\n");\
+	exit(-1);\
+  }
+
+static void read_inputs() {
+  int i, j, n;
+
+  /* every repetition reads the input again; drop the cells of the last one */
+  if (gcells != NULL) {
+      for (i = 1; i < N + 1; i++) free(gcells[i].alt);
+      free(gcells);
+  }
+
+  read_integer(inputFile,n);
+  N = n;
+  
+  gcells = (struct cell *) malloc((n + 1) * sizeof(struct cell));
+
+  gcells[0].n     =  0;
+  gcells[0].alt   =  0;
+  gcells[0].top   =  0;
+  gcells[0].bot   =  0;
+  gcells[0].lhs   = -1;
+  gcells[0].rhs   = -1;
+  gcells[0].left  =  0;
+  gcells[0].above =  0;
+  gcells[0].next  =  0;
+
+  for (i = 1; i < n + 1; i++) {
+
+      read_integer(inputFile, gcells[i].n);
+      gcells[i].alt = (coor *) malloc(gcells[i].n * sizeof(coor));
+
+      for (j = 0; j < gcells[i].n; j++) {
+          read_integer(inputFile, gcells[i].alt[j][0]);
+          read_integer(inputFile, gcells[i].alt[j][1]);
+      }
+
+      read_integer(inputFile, gcells[i].left);
+      read_integer(inputFile, gcells[i].above);
+      read_integer(inputFile, gcells[i].next);
+      }
+
+  if (!feof(inputFile)) {
+      read_integer(inputFile, solution);
+  }
+}
+
+
+static void write_outputs() {
+  int i, j;
+
+    bots_message("Minimum area = %d\n\n", MIN_AREA.load());
+
+    for (i = 0; i < MIN_FOOTPRINT[0]; i++) {
+      for (j = 0; j < MIN_FOOTPRINT[1]; j++) {
+          if (BEST_BOARD[i][j] == 0) {bots_message(" ");}
+          else                       bots_message("%c", 'A' + BEST_BOARD[i][j] - 1);
+      } 
+      bots_message("\n");
+    }  
+}
+
+
+/* A task's private copy of the board and of the cells. Only the first
+ * rows of a board can be non-empty, so a recycled frame remembers how many
+ * rows it has dirtied and copying a board touches just those rows. */
+struct frame {
+  struct frame *next;
+  int           rows;     /* rows of board that may be non-zero */
+  ibrd          board;
+  struct cell  *cells;    /* N+1 cells, allocated right after the frame */
+};
+
+static oneapi::tbb::enumerable_thread_specific<struct frame *,
+	oneapi::tbb::cache_aligned_allocator<struct frame *>,
+	oneapi::tbb::ets_key_per_instance> frame_pool((struct frame *) NULL);
+static std::atomic<int> frames_allocated;
+
+static struct frame * get_frame() {
+  struct frame *&head = frame_pool.local();
+  struct frame *f = head;
+
+  if (f != NULL) {
+     head = f->next;
+     return f;
+  }
+  f = (struct frame *) malloc(sizeof(struct frame) + (N + 1) * sizeof(struct cell));
+  if (f == NULL) {
+     bots_message("Error: Out of memory\n");
+     exit(101);
+  }
+  f->rows  = ROWS;
+  f->cells = (struct cell *) (f + 1);
+  frames_allocated++;
+  return f;
+}
+
+/* frames go back to the list of the thread finishing the task */
+static void put_frame(struct frame *f) {
+  struct frame *&head = frame_pool.local();
+
+  f->next = head;
+  head = f;
+}
+
+static void free_frames() {
+  for (struct frame *&head : frame_pool)
+     while (head != NULL) {
+        struct frame *f = head;
+        head = f->next;
+        free(f);
+     }
+  frame_pool.clear();
+}
+
+/* copy the first rows of BOARD (the rest is empty) into f */
+static void copy_board(struct frame *f, ibrd BOARD, int rows) {
+  memcpy(f->board, BOARD, rows * sizeof(f->board[0]));
+  if (f->rows > rows)
+     memset(f->board[rows], 0, (f->rows - rows) * sizeof(f->board[0]));
+  f->rows = rows;
+}
+
+static void update_best(int area, coor footprint, ibrd board) {
+  oneapi::tbb::spin_mutex::scoped_lock lock(best_lock);
+
+  if (area < MIN_AREA.load(std::memory_order_relaxed)) {
+     MIN_AREA.store(area, std::memory_order_relaxed);
+     MIN_FOOTPRINT[0] = footprint[0];
+     MIN_FOOTPRINT[1] = footprint[1];
+     memcpy(BEST_BOARD, board, sizeof(ibrd));
+     bots_debug("N  %d\n", area);
+  }
+}
+
+#ifdef MANUAL_CUTOFF
+static int add_cell_ser (int id, coor FOOTPRINT, ibrd BOARD, struct cell *cells) {
+  int  i, j, nn, nn2, area;
+
+  struct frame *f = get_frame();
+  coor footprint, NWS[DMAX];
+
+  nn2 = 0;
+
+/* for each possible shape */
+  for (i = 0; i < cells[id].n; i++) {
+/* compute all possible locations for nw corner */
+      nn = starts(id, i, NWS, cells);
+      nn2 += nn;
+/* for all possible locations */
+      for (j = 0; j < nn; j++) {
+/* extent of shape */
+          cells[id].top = NWS[j][0];
+          cells[id].bot = cells[id].top + cells[id].alt[i][0] - 1;
+          cells[id].lhs = NWS[j][1];
+          cells[id].rhs = cells[id].lhs + cells[id].alt[i][1] - 1;
+
+          copy_board(f, BOARD, FOOTPRINT[0]);
+          f->rows = max(f->rows, cells[id].bot+1);
+
+/* if the cell cannot be layed down, prune search */
+          if (! lay_down(id, f->board, cells)) {
+             bots_debug("Chip %d, shape %d does not fit\n", id, i);
+             continue;
+          }
+
+/* calculate new footprint of board and area of footprint */
+          footprint[0] = max(FOOTPRINT[0], cells[id].bot+1);
+          footprint[1] = max(FOOTPRINT[1], cells[id].rhs+1);
+          area         = footprint[0] * footprint[1];
+
+/* if last cell */
+          if (cells[id].next == 0) {
+
+/* if area is minimum, update global values */
+             if (area < MIN_AREA.load(std::memory_order_relaxed))
+                update_best(area, footprint, f->board);
+
+/* if area is less than best area */
+          } else if (area < MIN_AREA.load(std::memory_order_relaxed)) {
+             nn2 += add_cell_ser(cells[id].next, footprint, f->board, cells);
+
+/* if area is greater than or equal to best area, prune search */
+          } else {
+
+             bots_debug("T  %d, %d\n", area, MIN_AREA.load());
+
+          }
+      }
+  }
+  put_frame(f);
+  return nn2;
+}
+#endif
+
+static int add_cell(int id, coor FOOTPRINT, ibrd BOARD, struct cell *CELLS, int level);
+
+/* lay cell id down with the given shape and nw corner on a copy of the
+ * board and go on with the next cell */
+static int place_cell(int id, int shape, int top, int lhs, coor FOOTPRINT, ibrd BOARD, struct cell *CELLS, int level) {
+  int  area, nnc = 0;
+
+  struct frame *f = get_frame();
+  struct cell *cells = f->cells;
+  coor footprint;
+
+  memcpy(cells, CELLS, sizeof(struct cell)*(N+1));
+/* extent of shape */
+  cells[id].top = top;
+  cells[id].bot = cells[id].top + cells[id].alt[shape][0] - 1;
+  cells[id].lhs = lhs;
+  cells[id].rhs = cells[id].lhs + cells[id].alt[shape][1] - 1;
+
+  copy_board(f, BOARD, FOOTPRINT[0]);
+  f->rows = max(f->rows, cells[id].bot+1);
+
+/* if the cell cannot be layed down, prune search */
+  if (! lay_down(id, f->board, cells)) {
+     bots_debug("Chip %d, shape %d does not fit\n", id, shape);
+     put_frame(f);
+     return 0;
+  }
+
+/* calculate new footprint of board and area of footprint */
+  footprint[0] = max(FOOTPRINT[0], cells[id].bot+1);
+  footprint[1] = max(FOOTPRINT[1], cells[id].rhs+1);
+  area         = footprint[0] * footprint[1];
+
+/* if last cell */
+  if (cells[id].next == 0) {
+
+/* if area is minimum, update global values */
+     if (area < MIN_AREA.load(std::memory_order_relaxed))
+        update_best(area, footprint, f->board);
+
+/* if area is less than best area */
+  } else if (area < MIN_AREA.load(std::memory_order_relaxed)) {
+#ifdef MANUAL_CUTOFF
+     if (level+1 < bots_cutoff_value)
+        nnc = add_cell(cells[id].next, footprint, f->board, cells, level+1);
+     else
+        nnc = add_cell_ser(cells[id].next, footprint, f->board, cells);
+#else
+     nnc = add_cell(cells[id].next, footprint, f->board, cells, level+1);
+#endif
+
+/* if area is greater than or equal to best area, prune search */
+  } else {
+
+     bots_debug("T  %d, %d\n", area, MIN_AREA.load());
+
+  }
+  put_frame(f);
+  return nnc;
+}
+
+static int add_cell(int id, coor FOOTPRINT, ibrd BOARD, struct cell *CELLS, int level) {
+  int  i, j, nn, nnl;
+  std::atomic<int> nnc(0);
+
+  coor NWS[DMAX];
+  counting_task_group g;
+
+  nnl = 0;
+
+/* for each possible shape */
+  for (i = 0; i < CELLS[id].n; i++) {
+/* compute all possible locations for nw corner */
+      nn = starts(id, i, NWS, CELLS);
+      nnl += nn;
+/* for all possible locations */
+      for (j = 0; j < nn; j++) {
+          int top = NWS[j][0], lhs = NWS[j][1];
+
+          g.run([=, &nnc] {
+             nnc += place_cell(id, i, top, lhs, FOOTPRINT, BOARD, CELLS, level);
+          });
+      }
+  }
+  g.wait();
+  return nnc + nnl;
+}
+
+ibrd board;
+static int nodes;   /* nodes explored by the last add_cell */
+
+extern "C" void floorplan_init (char *filename)
+{
+    int i,j;
+
+    inputFile = fopen(filename, "r");
+    
+    if(NULL == inputFile) {
+        bots_message("Couldn't open %s file for reading\n", filename);
+        exit(1);
+    }
+    
+    /* read input file and initialize global minimum area */
+    read_inputs();
+    fclose(inputFile);
+    MIN_AREA = ROWS * COLS;
+    frames_allocated = 0;
+    
+    /* initialize board is empty */
+    for (i = 0; i < ROWS; i++)
+    for (j = 0; j < COLS; j++) board[i][j] = 0;
+
+    init_arenaptr();
+}
+
+extern "C" void compute_floorplan (void)
+{
+    coor footprint;
+    /* footprint of initial board is zero */
+    footprint[0] = 0;
+    footprint[1] = 0;
+    bots_message("Computing floorplan ");
+    arenaptr->execute([&] {
+       nodes = add_cell(1, footprint, board, gcells, 0);
+    });
+    bots_message(" completed!\n");
+
+}
+
+extern "C" void floorplan_end (void)
+{
+    fini_arenaptr();
+    /* report the explored nodes, as the OpenMP versions do */
+    bots_number_of_tasks = nodes;
+    free_frames();
+    /* write results */
+    write_outputs();
+    bots_message("Board frames allocated = %d\n", frames_allocated.load());
+}
+
+extern "C" int floorplan_verify (void)
+{
+    if (solution != -1 )
+      return MIN_AREA == solution ? BOTS_RESULT_SUCCESSFUL : BOTS_RESULT_UNSUCCESSFUL;
+    else
+      return BOTS_RESULT_NA;
+}
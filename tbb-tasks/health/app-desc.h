@@ -38,16 +38,18 @@ extern int sim_level;
 
 void read_input_data(char *filename);
 void allocate_village( struct Village **capital, struct Village *back, struct Village *next, int level, int32_t vid);
+void free_village(struct Village *village);
 void sim_village_main_par(struct Village *top);
 void par_init();
 void par_fini();
 int check_village(struct Village *top);
 
 #define BOTS_APP_INIT \
-   struct Village *top;\
+   struct Village *top = NULL;\
    read_input_data(bots_arg_file);
 
 #define KERNEL_INIT \
+   free_village(top); \
    allocate_village(&top, NULL, NULL, sim_level, 0); \
    par_init();
 
@@ -179,6 +179,41 @@ allocate_village( struct Village **capital, struct Village *back,
 	}
 }
 /**********************************************************************/
+static void
+free_patients(struct Patient *list)
+{
+	struct Patient *p;
+
+	while (list != NULL)
+	{
+		p = list;
+		list = list->forward;
+		free(p);
+	}
+}
+/**********************************************************************/
+void
+free_village(struct Village *village)
+{
+	struct Village *vlist, *vnext;
+
+	if (village == NULL) return;
+	vlist = village->forward;
+	while (vlist)
+	{
+		vnext = vlist->next;
+		free_village(vlist);
+		vlist = vnext;
+	}
+	/* every patient is in exactly one list of one village */
+	free_patients(village->population);
+	free_patients(village->hosp.waiting);
+	free_patients(village->hosp.assess);
+	free_patients(village->hosp.inside);
+	free_patients(village->hosp.realloc);
+	free(village);
+}
+/**********************************************************************/
 struct Results
 get_results(struct Village *village)
 {
@@ -419,7 +454,7 @@ void
 sim_village_par(struct Village *village)
 {
 	struct Village *vlist;
-	oneapi::tbb::task_group g;
+	counting_task_group g;
 
 	// lowest level returns nothing
 	// only for sim_village first call with village = NULL
@@ -472,7 +507,7 @@ void
 sim_village_par(struct Village *village)
 {
 	struct Village *vlist;
-	oneapi::tbb::task_group g;
+	counting_task_group g;
 
 	// lowest level returns nothing
 	// only for sim_village first call with village = NULL
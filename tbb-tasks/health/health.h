@@ -93,6 +93,7 @@ struct Results get_results(struct Village *village);
 
 extern "C" void read_input_data(char *filename);
 extern "C" void allocate_village( struct Village **capital, struct Village *back, struct Village *next, int level, int32_t vid);
+extern "C" void free_village(struct Village *village);
 extern "C" void sim_village_main_par(struct Village *top);
 extern "C" void par_init();
 extern "C" void par_fini();
@@ -0,0 +1,51 @@
+/**********************************************************************************************/
+/*  This program is part of the Barcelona OpenMP Tasks Suite                                  */
+/*  Copyright (C) 2009 Barcelona Supercomputing Center - Centro Nacional de Supercomputacion  */
+/*  Copyright (C) 2009 Universitat Politecnica de Catalunya                                   */
+/*                                                                                            */
+/*  This program is free software; you can redistribute it and/or modify                      */
+/*  it under the terms of the GNU General Public License as published by                      */
+/*  the Free Software Foundation; either version 2 of the License, or                         */
+/*  (at your option) any later version.                                                       */
+/*                                                                                            */
+/*  This program is distributed in the hope that it will be useful,                           */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of                            */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                             */
+/*  GNU General Public License for more details.                                              */
+/*                                                                                            */
+/*  You should have received a copy of the GNU General Public License                         */
+/*  along with this program; if not, write to the Free Software                               */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA            */
+/**********************************************************************************************/
+
+#include "tbb-tasks-app.h"
+#include "knapsack.h"
+
+#define BOTS_APP_NAME "Knapsack"
+#define BOTS_APP_PARAMETERS_DESC "%s"
+#define BOTS_APP_PARAMETERS_LIST ,bots_arg_file
+
+#define BOTS_APP_CHECK_USES_SEQ_RESULT
+
+#define BOTS_APP_USES_ARG_FILE
+#define BOTS_APP_DEF_ARG_FILE "Input filename"
+#define BOTS_APP_DESC_ARG_FILE "Knapsack input file (mandatory)"
+
+#define BOTS_CUTOFF_DEF_VALUE 24
+
+#define BOTS_APP_INIT\
+     struct item items[MAX_ITEMS];\
+     int n, capacity;\
+     int sol_seq = 0, sol_par = 0;\
+     if (read_input(bots_arg_file, items, &capacity, &n) != 0) exit(101);
+
+#define KERNEL_INIT knapsack_init();
+#define KERNEL_CALL knapsack_main_par(items, capacity, n, &sol_par);
+#define KERNEL_FINI knapsack_fini();
+
+#define KERNEL_SEQ_INIT
+#define KERNEL_SEQ_CALL knapsack_main_seq(items, capacity, n, &sol_seq);
+#define KERNEL_SEQ_FINI
+
+#define KERNEL_CHECK  knapsack_check(sol_seq, sol_par)
+
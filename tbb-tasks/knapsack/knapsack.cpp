@@ -0,0 +1,259 @@
+/**********************************************************************************************/
+/*  This program is part of the Barcelona OpenMP Tasks Suite                                  */
+/*  Copyright (C) 2009 Barcelona Supercomputing Center - Centro Nacional de Supercomputacion  */
+/*  Copyright (C) 2009 Universitat Politecnica de Catalunya                                   */
+/*                                                                                            */
+/*  This program is free software; you can redistribute it and/or modify                      */
+/*  it under the terms of the GNU General Public License as published by                      */
+/*  the Free Software Foundation; either version 2 of the License, or                         */
+/*  (at your option) any later version.                                                       */
+/*                                                                                            */
+/*  This program is distributed in the hope that it will be useful,                           */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of                            */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                             */
+/*  GNU General Public License for more details.                                              */
+/*                                                                                            */
+/*  You should have received a copy of the GNU General Public License                         */
+/*  along with this program; if not, write to the Free Software                               */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA            */
+/**********************************************************************************************/
+
+/*
+ * Original code from the Cilk project
+ *
+ * Copyright (c) 2000 Massachusetts Institute of Technology
+ * Copyright (c) 2000 Matteo Frigo
+ */
+
+/*
+ * oneTBB version. The best solution so far is an atomic that only grows
+ * (CAS max) and is published as soon as a feasible solution is found, so
+ * every task prunes against the real incumbent instead of a racy copy.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <atomic>
+#include <oneapi/tbb.h>
+
+#include "bots.h"
+#include "knapsack.h"
+#include "arena.h"
+
+static std::atomic<int> best_so_far;
+
+/* Per-thread (cache-line padded) count of visited nodes and of the nodes
+ * cut by the bound, which tell the work done apart from the scheduling */
+typedef struct {
+     unsigned long long visited, pruned;
+} knapsack_stats_t;
+
+static oneapi::tbb::enumerable_thread_specific<knapsack_stats_t,
+	oneapi::tbb::cache_aligned_allocator<knapsack_stats_t>,
+	oneapi::tbb::ets_key_per_instance> stats;
+
+static int compare(const void *pa, const void *pb)
+{
+     const struct item *a = (const struct item *) pa, *b = (const struct item *) pb;
+     double c = ((double) a->value / a->weight) -
+     ((double) b->value / b->weight);
+
+     if (c > 0) return -1;
+     if (c < 0) return 1;
+     return 0;
+}
+
+extern "C" int read_input(const char *filename, struct item *items, int *capacity, int *n)
+{
+     int i;
+     FILE *f;
+
+     if (filename == NULL) filename = "\0";
+     f = fopen(filename, "r");
+     if (f == NULL) {
+	  fprintf(stderr, "open_input(\"%s\") failed\n", filename);
+	  return -1;
+     }
+     /* format of the input: #items capacity value1 weight1 ... */
+     if (fscanf(f, "%d %d", n, capacity) != 2 || *n < 0 || *n > MAX_ITEMS) {
+	  fprintf(stderr, "open_input(\"%s\"): bad header\n", filename);
+	  fclose(f);
+	  return -1;
+     }
+
+     for (i = 0; i < *n; ++i)
+	  if (fscanf(f, "%d %d", &items[i].value, &items[i].weight) != 2) {
+	       fprintf(stderr, "open_input(\"%s\"): missing item %d\n", filename, i);
+	       fclose(f);
+	       return -1;
+	  }
+
+     fclose(f);
+
+     /* sort the items on decreasing order of value/weight */
+     qsort(items, *n, sizeof(struct item), compare);
+
+     return 0;
+}
+
+/* Raise the incumbent to v unless some other task already did better */
+static inline void update_best(int v)
+{
+     int cur = best_so_far.load(std::memory_order_relaxed);
+
+     while (v > cur && !best_so_far.compare_exchange_weak(cur, v, std::memory_order_relaxed))
+	  ;
+}
+
+/* 
+ * return the optimal solution for n items (first is e) and
+ * capacity c. Value so far is v.
+ */
+static int knapsack_seq(struct item *e, int c, int n, int v)
+{
+     int with, without;
+     double ub;
+     knapsack_stats_t &st = stats.local();
+
+     st.visited++;
+     /* base case: full knapsack or no items */
+     if (c < 0) return INT_MIN;
+
+     /* feasible solution, with value v */
+     if (n == 0 || c == 0) {
+	  update_best(v);
+	  return v;
+     }
+
+     ub = (double) v + c * e->value / e->weight;
+
+     /* a stale (smaller) bound only prunes less, so relaxed is enough */
+     if (ub < best_so_far.load(std::memory_order_relaxed)) {
+	  /* prune ! */
+	  st.pruned++;
+	  return INT_MIN;
+     }
+
+     /* compute the best solution with the current item in the knapsack;
+      * going greedy first finds a good incumbent early, and it is also
+      * the branch the parallel version runs without spawning */
+     with = knapsack_seq(e + 1, c - e->weight, n - 1, v + e->value);
+
+     /* compute the best solution without the current item in the knapsack */
+     without = knapsack_seq(e + 1, c, n - 1, v);
+
+     return with > without ? with : without;
+}
+
+#if defined(MANUAL_CUTOFF)
+static int knapsack_par(struct item *e, int c, int n, int v, int l)
+#else
+static int knapsack_par(struct item *e, int c, int n, int v)
+#endif
+{
+     int with, without;
+     double ub;
+     knapsack_stats_t &st = stats.local();
+
+#if defined(MANUAL_CUTOFF)
+     if (l >= bots_cutoff_value) return knapsack_seq(e, c, n, v);
+#endif
+
+     st.visited++;
+     /* base case: full knapsack or no items */
+     if (c < 0) return INT_MIN;
+
+     /* feasible solution, with value v */
+     if (n == 0 || c == 0) {
+	  update_best(v);
+	  return v;
+     }
+
+     ub = (double) v + c * e->value / e->weight;
+
+     if (ub < best_so_far.load(std::memory_order_relaxed)) {
+	  /* prune ! */
+	  st.pruned++;
+	  return INT_MIN;
+     }
+
+     counting_task_group g;
+
+     /* compute the best solution without the current item in the knapsack */
+     g.run([=, &without] {
+#if defined(MANUAL_CUTOFF)
+     without = knapsack_par(e + 1, c, n - 1, v, l + 1);
+#else
+     without = knapsack_par(e + 1, c, n - 1, v);
+#endif
+     });
+
+     /* compute the best solution with the current item in the knapsack */
+#if defined(MANUAL_CUTOFF)
+     with = knapsack_par(e + 1, c - e->weight, n - 1, v + e->value, l + 1);
+#else
+     with = knapsack_par(e + 1, c - e->weight, n - 1, v + e->value);
+#endif
+
+     g.wait();
+     return with > without ? with : without;
+}
+
+static void knapsack_show_stats(const char *pass)
+{
+     knapsack_stats_t total = stats.combine([](const knapsack_stats_t &a, const knapsack_stats_t &b) {
+	  return knapsack_stats_t{a.visited + b.visited, a.pruned + b.pruned};
+     });
+
+     bots_message("Nodes visited (%s) = %llu, pruned by the bound = %llu (%.2f%%)\n",
+	  pass, total.visited, total.pruned,
+	  total.visited ? 100.0 * total.pruned / total.visited : 0.0);
+}
+
+extern "C" void knapsack_main_par (struct item *e, int c, int n, int *sol)
+{
+     best_so_far = INT_MIN;
+     stats.clear();
+
+     arenaptr->execute([&] {
+#if defined(MANUAL_CUTOFF)
+     *sol = knapsack_par(e, c, n, 0, 0);
+#else
+     *sol = knapsack_par(e, c, n, 0);
+#endif
+     });
+
+     if (bots_verbose_mode) printf("Best value for parallel execution is %d\n\n", *sol);
+}
+
+extern "C" void knapsack_main_seq (struct item *e, int c, int n, int *sol)
+{
+     best_so_far = INT_MIN;
+     stats.clear();
+
+     *sol = knapsack_seq(e, c, n, 0);
+
+     if (bots_verbose_mode) printf("Best value for sequential execution is %d\n\n", *sol);
+     knapsack_show_stats("sequential");
+}
+
+extern "C" int  knapsack_check (int sol_seq, int sol_par)
+{
+   if (sol_seq == sol_par) return BOTS_RESULT_SUCCESSFUL;
+   else return BOTS_RESULT_UNSUCCESSFUL;
+}
+
+extern "C" void
+knapsack_init()
+{
+	init_arenaptr();
+}
+
+extern "C" void
+knapsack_fini()
+{
+	fini_arenaptr();
+	knapsack_show_stats("parallel");
+}
@@ -0,0 +1,46 @@
+/**********************************************************************************************/
+/*  This program is part of the Barcelona OpenMP Tasks Suite                                  */
+/*  Copyright (C) 2009 Barcelona Supercomputing Center - Centro Nacional de Supercomputacion  */
+/*  Copyright (C) 2009 Universitat Politecnica de Catalunya                                   */
+/*                                                                                            */
+/*  This program is free software; you can redistribute it and/or modify                      */
+/*  it under the terms of the GNU General Public License as published by                      */
+/*  the Free Software Foundation; either version 2 of the License, or                         */
+/*  (at your option) any later version.                                                       */
+/*                                                                                            */
+/*  This program is distributed in the hope that it will be useful,                           */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of                            */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                             */
+/*  GNU General Public License for more details.                                              */
+/*                                                                                            */
+/*  You should have received a copy of the GNU General Public License                         */
+/*  along with this program; if not, write to the Free Software                               */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA            */
+/**********************************************************************************************/
+#ifndef KNAPSACK_H
+#define KNAPSACK_H
+
+#define MAX_ITEMS 256
+
+struct item {
+     int value;
+     int weight;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int read_input(const char *filename, struct item *items, int *capacity, int *n);
+void knapsack_main_seq (struct item *e, int c, int n, int *sol);
+void knapsack_main_par (struct item *e, int c, int n, int *sol);
+int  knapsack_check (int sol_seq, int sol_par);
+
+void knapsack_init();
+void knapsack_fini();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -28,8 +28,6 @@
 #define BOTS_APP_DEF_ARG_SIZE 14
 #define BOTS_APP_DESC_ARG_SIZE "Board size"
 
-int ok(int n, char *a);
-
 void init_queens();
 int verify_queens(int);
 void find_queens (int);
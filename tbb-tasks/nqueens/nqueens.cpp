@@ -25,19 +25,17 @@
  * Copyright (c) 2000 Matteo Frigo
  */
 
-#include <atomic>
+#include <functional>
 #include <oneapi/tbb.h>
 #include <stdlib.h>
 #include <stdio.h>
-#include <memory.h>
-#include <alloca.h>
 #include "bots.h"
 #include "arena.h"
 
 
 /* Checking information */
 
-static int solutions[] = {
+static long long solutions[] = {
         1,
         0,
         0,
@@ -52,147 +50,102 @@ static int solutions[] = {
         14200,
         73712,
         365596,
+        2279184, /* 15 */
+        14772512,
+        95815104,
+        666090624,
+        4968057848LL,
+        39029188884LL, /* 20 */
+        314666222712LL,
+        2691008701644LL,
+        24233937684440LL,
+        227514171973736LL,
+        2207893435808352LL, /* 25 */
+        22317699616364044LL,
+        234907967154122528LL,
 };
-#define MAX_SOLUTIONS sizeof(solutions)/sizeof(int)
+#define MAX_SOLUTIONS sizeof(solutions)/sizeof(long long)
 
-/* XXX: Using std::atomic instead of omp atomic */
-std::atomic<int> total_count;
+/* Boards are bitmasks of one bit per column, so n is limited by its width */
+#define MAX_BOARD 31
+
+long long total_count;
+
+/* Solutions found by each thread, added up once the search is over */
+static oneapi::tbb::combinable<long long> thread_counts;
 
 /*
- * <a> contains array of <n> queen positions.  Returns 1
- * if none of the queens conflict, and returns 0 otherwise.
+ * The partial placement of rows 0..j-1 is kept as three masks: the
+ * columns taken, and the squares of row j attacked along the left and
+ * right diagonals. Placing a queen on bit <bit> of row j gives the masks
+ * of row j+1, so no placement needs to be checked again.
  */
-int ok(int n, char *a)
+static long long nqueens_ser (int n, int j, unsigned cols, unsigned ld, unsigned rd)
 {
-     int i, j;
-     char p, q;
-
-     for (i = 0; i < n; i++) {
-	  p = a[i];
-
-	  for (j = i + 1; j < n; j++) {
-	       q = a[j];
-	       if (q == p || q == p - (j - i) || q == p + (j - i))
-		    return 0;
-	  }
-     }
-     return 1;
-}
-
-void nqueens_ser (int n, int j, char *a, std::atomic<int> *solutions)
-{
-	std::atomic<int> res;
-	int i;
+	unsigned avail, bit;
+	long long count = 0;
 
 	if (n == j) {
 		/* good solution, count it */
-		*solutions = 1;
-		return;
+		return 1;
 	}
 
-	*solutions = 0;
-
-     	/* try each possible position for queen <j> */
-	for (i = 0; i < n; i++) {
-		{
-	  		/* allocate a temporary array and copy <a> into it */
-	  		a[j] = (char) i;
-	  		if (ok(j + 1, a)) {
-	       			nqueens_ser(n, j + 1, a,&res);
-				*solutions += res;
-			}
-		}
+     	/* try each free position for queen <j> */
+	avail = ~(cols | ld | rd) & ((1u << n) - 1);
+	while (avail) {
+		bit = avail & -avail;
+		avail -= bit;
+		count += nqueens_ser(n, j + 1, cols | bit, (ld | bit) << 1, (rd | bit) >> 1);
 	}
+	return count;
 }
 
-#if defined(MANUAL_CUTOFF)
-
-void nqueens(int n, int j, char *a, std::atomic<int> *solutions, int depth)
-{
-	std::atomic<int> *csols;
-	bots_debug_with_location_info("entered nqueens()");
-	int i;
-
-
-	if (n == j) {
-		/* good solution, count it */
-		*solutions = 1;
-		return;
-	}
-
+/*
+ * Everything a task needs to go on from row j, small enough to be copied
+ * into the task itself: no board is allocated or copied. Solutions below
+ * it count <weight> times (see the mirror symmetry below).
+ */
+struct queens_state {
+	unsigned cols, ld, rd;
+	short j, weight;
 
-	*solutions = 0;
-	csols = (std::atomic<int> *)alloca(n*sizeof(int));
-	memset(csols,0,n*sizeof(int));
-
-	oneapi::tbb::task_group g;
-     	/* try each possible position for queen <j> */
-	for (i = 0; i < n; i++) {
-		if ( depth < bots_cutoff_value ) {
-			g.run([=, &csols] {
-	  			/* allocate a temporary array and copy <a> into it */
-	  			char * b = (char *)alloca(n * sizeof(char));
-	  			memcpy(b, a, j * sizeof(char));
-	  			b[j] = (char) i;
-	  			if (ok(j + 1, b))
-	       				nqueens(n, j + 1, b,&csols[i],depth+1);
-			});
-		} else {
-  			a[j] = (char) i;
-  			if (ok(j + 1, a))
-       				nqueens_ser(n, j + 1, a,&csols[i]);
-		}
+	queens_state place(unsigned bit) const {
+		return { cols | bit, (ld | bit) << 1, (rd | bit) >> 1, (short) (j + 1), weight };
 	}
+};
 
-	g.wait();
-	for ( i = 0; i < n; i++) *solutions += csols[i];
-}
-
-
-#else 
-
-void nqueens(int n, int j, char *a, std::atomic<int> *solutions, int depth)
+void nqueens(int n, queens_state s)
 {
-	bots_debug_with_location_info("entered nqueens(), *solutions = %d\n",
-			solutions->load());
-	std::atomic<int> *csols;
-	int i;
+	unsigned avail, bit;
 
+	bots_debug_with_location_info("entered nqueens()");
 
-	if (n == j) {
+	if (n == s.j) {
 		/* good solution, count it */
-		*solutions = 1;
-	bots_debug_with_location_info("good solution, count it, *solutions = %d\n",
-			solutions->load());
+		thread_counts.local() += s.weight;
 		return;
 	}
 
+#if defined(MANUAL_CUTOFF)
+	/* the cutoff is the number of rows placed by tasks */
+	if (s.j >= bots_cutoff_value) {
+		thread_counts.local() += s.weight * nqueens_ser(n, s.j, s.cols, s.ld, s.rd);
+		return;
+	}
+#endif
 
-	*solutions = 0;
-	csols = (std::atomic<int> *)alloca(n*sizeof(int));
-	memset(csols,0,n*sizeof(int));
-
-	oneapi::tbb::task_group g;
-     	/* try each possible position for queen <j> */
-	for (i = 0; i < n; i++) {
-		g.run([=, &csols] {
-	  		/* allocate a temporary array and copy <a> into it */
-	  		char * b = (char *)alloca(n * sizeof(char));
-	  		memcpy(b, a, j * sizeof(char));
-	  		b[j] = (char) i;
-	  		if (ok(j + 1, b))
-       				nqueens(n, j + 1, b,&csols[i],depth); //FIXME: depth or depth+1 ???
-		});
+	counting_task_group g;
+     	/* try each free position for queen <j> */
+	avail = ~(s.cols | s.ld | s.rd) & ((1u << n) - 1);
+	while (avail) {
+		bit = avail & -avail;
+		avail -= bit;
+		g.run([=] { nqueens(n, s.place(bit)); });
 	}
 
 	g.wait();
-	for ( i = 0; i < n; i++) *solutions += csols[i];
-	bots_debug_with_location_info("leaving nqueens, *solutions = %d\n",
-			solutions->load());
 }
 
-#endif
-
 
 extern "C" void
 init_queens()
@@ -206,19 +159,51 @@ cleanup_queens()
 	fini_arenaptr();
 }
 
+/*
+ * Mirror symmetry: the reflection of a solution has its first queen on
+ * column n-1-c, so only the first half of row 0 is explored and counted
+ * twice, plus the middle column once when n is odd. Enabled with
+ * BOTS_NQUEENS_SYMMETRY=1.
+ */
+static bool symmetry_enabled()
+{
+	char *sym_a = getenv("BOTS_NQUEENS_SYMMETRY");
+	return sym_a && atoi(sym_a) > 0;
+}
+
+static void nqueens_mirror(int n)
+{
+	int i;
+
+	counting_task_group g;
+	for (i = 0; i < (n + 1) / 2; i++) {
+		/* the middle column of an odd board is its own mirror */
+		queens_state s = { 0, 0, 0, 0, (short) (n % 2 && i == n / 2 ? 1 : 2) };
+		g.run([=] { nqueens(n, s.place(1u << i)); });
+	}
+	g.wait();
+}
+
 extern "C" void find_queens (int size)
 {
+	bool symmetry = symmetry_enabled();
+
 	total_count=0;
 
-        bots_message("Computing N-Queens algorithm (n=%d) ", size);
-	arenaptr->execute([=] {
-		{
-			char *a;
+	if (size < 1 || size > MAX_BOARD) {
+		bots_message("Error: board size (%d) must be between 1 and %d\n", size, MAX_BOARD);
+		exit(101);
+	}
 
-			a = (char *)alloca(size * sizeof(char));
-			nqueens(size, 0, a, &total_count,0);
-		}
+        bots_message("Computing N-Queens algorithm (n=%d%s) ", size, symmetry ? ", mirror symmetry" : "");
+	thread_counts.clear();
+	arenaptr->execute([=] {
+		if (symmetry)
+			nqueens_mirror(size);
+		else
+			nqueens(size, queens_state{ 0, 0, 0, 0, 1 });
 	});
+	total_count = thread_counts.combine(std::plus<long long>());
 	bots_message(" completed!\n");
 }
 
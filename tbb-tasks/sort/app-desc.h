@@ -21,8 +21,10 @@
 #include "tbb-tasks-app.h"
 
 #define BOTS_APP_NAME "Sort"
-#define BOTS_APP_PARAMETERS_DESC "N=%d:Q=%d:I=%d:M=%d"
-#define BOTS_APP_PARAMETERS_LIST ,bots_arg_size,bots_app_cutoff_value_1,bots_app_cutoff_value_2,bots_app_cutoff_value
+/* A algorithm, D input distribution, K key type, P payload bytes, L leaf
+ * sort kernel, G sequential merge kernel */
+#define BOTS_APP_PARAMETERS_DESC "N=%d:Q=%d:I=%d:M=%d:A=%s:D=%s:K=%s:P=%d:L=%s:G=%s"
+#define BOTS_APP_PARAMETERS_LIST ,bots_arg_size,bots_app_cutoff_value_1,bots_app_cutoff_value_2,bots_app_cutoff_value,sort_algorithm_name(),sort_input_name(),sort_key_name(),sort_payload_size(),sort_leaf_name(),sort_merge_name()
 
 #define BOTS_APP_USES_ARG_SIZE
 #define BOTS_APP_DEF_ARG_SIZE (32*1024*1024)
@@ -47,7 +49,14 @@
 
 void sort_par (void);
 void sort_init (void);
+void sort_reset (void);
 int sort_verify (void);
+const char *sort_algorithm_name (void);
+const char *sort_input_name (void);
+const char *sort_key_name (void);
+int sort_payload_size (void);
+const char *sort_leaf_name (void);
+const char *sort_merge_name (void);
 void par_init();
 void par_fini();
 
@@ -55,7 +64,7 @@ void par_fini();
 
 #define BOTS_APP_INIT sort_init()
 
-#define KERNEL_INIT par_init()
+#define KERNEL_INIT sort_reset(); par_init()
 #define KERNEL_CALL sort_par()
 #define KERNEL_CHECK sort_verify()
 #define KERNEL_FINI par_fini()
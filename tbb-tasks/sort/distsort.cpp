@@ -0,0 +1,254 @@
+/**********************************************************************************************/
+/*  This program is part of the Barcelona OpenMP Tasks Suite                                  */
+/*  Copyright (C) 2009 Barcelona Supercomputing Center - Centro Nacional de Supercomputacion  */
+/*  Copyright (C) 2009 Universitat Politecnica de Catalunya                                   */
+/*                                                                                            */
+/*  This program is free software; you can redistribute it and/or modify                      */
+/*  it under the terms of the GNU General Public License as published by                      */
+/*  the Free Software Foundation; either version 2 of the License, or                         */
+/*  (at your option) any later version.                                                       */
+/*                                                                                            */
+/*  This program is distributed in the hope that it will be useful,                           */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of                            */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                             */
+/*  GNU General Public License for more details.                                              */
+/*                                                                                            */
+/*  You should have received a copy of the GNU General Public License                         */
+/*  along with this program; if not, write to the Free Software                               */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA            */
+/**********************************************************************************************/
+
+/*
+ * Distribution sorts, the alternatives to cilksort selected with
+ * BOTS_SORT_ALGORITHM:
+ *
+ *   radix   LSD radix sort, one pass over the keys per 8-bit digit.
+ *           Digits that are the same in every key are skipped, so a
+ *           permutation of 0..n-1 takes ceil(log2(n)/8) passes. Its
+ *           cost is memory bandwidth, not comparisons.
+ *
+ *   sample  sample sort: splitters taken from a sorted random sample
+ *           cut the keys into buckets, and each bucket is then sorted
+ *           with cilksort on its own.
+ *
+ * Both move the keys between array and tmp with the same blocked
+ * counting scatter.
+ */
+
+#include <oneapi/tbb.h>
+#include <algorithm>
+#include <vector>
+#include <string.h>
+#include "bots.h"
+#include "sort.h"
+#include "arena.h"
+
+/* Smallest block of keys counted and scattered by one task */
+#define SCATTER_MIN_BLOCK (64*1024)
+
+/* Keys a block gathers per bucket before writing them out together */
+#define SCATTER_BUFFER 8
+
+#define RADIX_BITS 8
+#define RADIX_MASK ((1UL << RADIX_BITS) - 1)
+
+/* Samples taken per bucket to choose the splitters */
+#define SAMPLE_OVERSAMPLING 32
+
+static long scatter_blocks(long size)
+{
+	long nblocks = 4L * arena_max_concurrency();
+
+	if (nblocks > size / SCATTER_MIN_BLOCK)
+		nblocks = size / SCATTER_MIN_BLOCK;
+	return nblocks > 0 ? nblocks : 1;
+}
+
+/*
+ * Moves src[0..size) to dst grouped by bucket(key), 0 <= bucket(key) <
+ * nbuckets, keeping the order of the keys within each bucket. Every block
+ * of src counts its keys per bucket, the counts become the place of the
+ * block's share of each bucket, and the blocks then copy their keys there
+ * in parallel. When start is not NULL, start[k] is set to where bucket k
+ * begins in dst (start has nbuckets + 1 entries).
+ */
+template <typename Bucket>
+static void scatter(ELM *src, ELM *dst, long size, long nbuckets, Bucket bucket, long *start)
+{
+	long nblocks = scatter_blocks(size);
+	std::vector<long> counts(nblocks * nbuckets, 0);
+	long *c = counts.data();
+	long offset = 0;
+
+	oneapi::tbb::parallel_for(oneapi::tbb::blocked_range<long>(0, nblocks, 1),
+		[=](const oneapi::tbb::blocked_range<long> &r) {
+			++task_counts.local();
+			for (long b = r.begin(); b != r.end(); b++) {
+				long *cb = c + b * nbuckets;
+				for (long i = size * b / nblocks; i < size * (b + 1) / nblocks; i++)
+					cb[bucket(src[i])]++;
+			}
+		}, oneapi::tbb::simple_partitioner());
+
+	for (long k = 0; k < nbuckets; k++) {
+		if (start)
+			start[k] = offset;
+		for (long b = 0; b < nblocks; b++) {
+			long n = c[b * nbuckets + k];
+			c[b * nbuckets + k] = offset;
+			offset += n;
+		}
+	}
+	if (start)
+		start[nbuckets] = offset;
+
+	oneapi::tbb::parallel_for(oneapi::tbb::blocked_range<long>(0, nblocks, 1),
+		[=](const oneapi::tbb::blocked_range<long> &r) {
+			++task_counts.local();
+			std::vector<ELM> buffers(nbuckets * SCATTER_BUFFER);
+			std::vector<int> fill(nbuckets);
+			for (long b = r.begin(); b != r.end(); b++) {
+				long *cb = c + b * nbuckets;
+				for (long i = size * b / nblocks; i < size * (b + 1) / nblocks; i++) {
+					long k = bucket(src[i]);
+					ELM *buf = &buffers[k * SCATTER_BUFFER];
+					buf[fill[k]++] = src[i];
+					if (fill[k] == SCATTER_BUFFER) {
+						memcpy(dst + cb[k], buf, sizeof(ELM) * SCATTER_BUFFER);
+						cb[k] += SCATTER_BUFFER;
+						fill[k] = 0;
+					}
+				}
+				for (long k = 0; k < nbuckets; k++) {
+					memcpy(dst + cb[k], &buffers[k * SCATTER_BUFFER], sizeof(ELM) * fill[k]);
+					cb[k] += fill[k];
+					fill[k] = 0;
+				}
+			}
+		}, oneapi::tbb::simple_partitioner());
+}
+
+static void copy_par(ELM *dst, ELM *src, long size)
+{
+	oneapi::tbb::parallel_for(oneapi::tbb::blocked_range<long>(0, size, SCATTER_MIN_BLOCK),
+		[=](const oneapi::tbb::blocked_range<long> &r) {
+			++task_counts.local();
+			memcpy(dst + r.begin(), src + r.begin(), r.size() * sizeof(ELM));
+		});
+}
+
+/* Orders the keys as unsigned integers (signed ones get their sign bit flipped) */
+static inline unsigned long radix_key(ELM x)
+{
+	typedef std::make_unsigned<KEY>::type UKEY;
+	UKEY k = (UKEY) key_of(x);
+
+	if (std::is_signed<KEY>::value)
+		k ^= (UKEY) 1 << (8 * sizeof(KEY) - 1);
+	return k;
+}
+
+struct key_bits {
+	unsigned long any, all;
+};
+
+void radixsort_par(ELM *low, ELM *tmp, long size)
+{
+	ELM *src = low, *dst = tmp, *t;
+	key_bits bits;
+	unsigned long varying;
+	int shift;
+
+	/* the bits set in some but not all keys */
+	bits = oneapi::tbb::parallel_reduce(
+		oneapi::tbb::blocked_range<long>(0, size, SCATTER_MIN_BLOCK),
+		key_bits{ 0, ~0UL },
+		[=](const oneapi::tbb::blocked_range<long> &r, key_bits b) {
+			++task_counts.local();
+			for (long i = r.begin(); i != r.end(); i++) {
+				b.any |= radix_key(low[i]);
+				b.all &= radix_key(low[i]);
+			}
+			return b;
+		},
+		[](key_bits a, key_bits b) { return key_bits{ a.any | b.any, a.all & b.all }; });
+	varying = bits.any ^ bits.all;
+
+	for (shift = 0; shift < 8 * (int) sizeof(KEY); shift += RADIX_BITS) {
+		if (!((varying >> shift) & RADIX_MASK))
+			continue;
+		scatter(src, dst, size, 1L << RADIX_BITS,
+			[=](ELM x) { return (radix_key(x) >> shift) & RADIX_MASK; }, NULL);
+		t = src;
+		src = dst;
+		dst = t;
+	}
+
+	if (src != low)
+		copy_par(low, src, size);
+}
+
+void samplesort_par(ELM *low, ELM *tmp, long size)
+{
+	long nbuckets = 2, nsamples, i, j, k;
+	int levels = 1;
+	unsigned long seed = 1;
+
+	/* a power of two, and every bucket still worth a cilksort of its own */
+	while (nbuckets < 8L * arena_max_concurrency() && 2 * nbuckets <= size / bots_app_cutoff_value_1) {
+		nbuckets *= 2;
+		levels++;
+	}
+	if (nbuckets > size / bots_app_cutoff_value_1) {
+		cilksort_par(low, tmp, size);
+		return;
+	}
+
+	/* a sample at pseudo-random places, so presorted input does no harm */
+	nsamples = nbuckets * SAMPLE_OVERSAMPLING;
+	std::vector<KEY> samples(nsamples);
+	for (i = 0; i < nsamples; i++) {
+		seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+		samples[i] = key_of(low[(seed >> 16) % size]);
+	}
+	std::sort(samples.begin(), samples.end());
+
+	/*
+	 * The nbuckets - 1 splitters are kept as an implicit binary search
+	 * tree (the children of node j are 2j and 2j+1), so finding the
+	 * bucket of a key takes <levels> compares and no branch. Keys equal
+	 * to a splitter go to the bucket before it.
+	 */
+	std::vector<KEY> tree(nbuckets);
+	for (j = 1; j < nbuckets; j++) {
+		/* node j at depth d is the splitter in the middle of its subtree */
+		int d = 63 - __builtin_clzl(j);
+		k = ((2 * (j - (1L << d)) + 1) << (levels - 1 - d)) - 1;
+		tree[j] = samples[(k + 1) * SAMPLE_OVERSAMPLING];
+	}
+
+	const KEY *t = tree.data();
+	std::vector<long> start(nbuckets + 1);
+	scatter(low, tmp, size, nbuckets,
+		[=](ELM x) {
+			long n = 1;
+			for (int l = 0; l < levels; l++)
+				n = 2 * n + (key_of(x) > t[n]);
+			return n - nbuckets;
+		},
+		start.data());
+
+	/* the buckets are sorted in tmp, with their part of low as scratch */
+	const long *st = start.data();
+	oneapi::tbb::parallel_for(oneapi::tbb::blocked_range<long>(0, nbuckets, 1),
+		[=](const oneapi::tbb::blocked_range<long> &r) {
+			++task_counts.local();
+			for (long b = r.begin(); b != r.end(); b++) {
+				long n = st[b + 1] - st[b];
+				if (n == 0)
+					continue;
+				cilksort_par(tmp + st[b], low + st[b], n);
+				memcpy(low + st[b], tmp + st[b], n * sizeof(ELM));
+			}
+		}, oneapi::tbb::simple_partitioner());
+}
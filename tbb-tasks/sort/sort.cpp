@@ -62,6 +62,9 @@
  */
 
 #include <oneapi/tbb.h>
+#include <algorithm>
+#include <vector>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -73,6 +76,31 @@
 
 ELM *array, *tmp;
 
+/* Top-level algorithm, chosen with BOTS_SORT_ALGORITHM */
+enum sort_algorithm { SORT_CILKSORT, SORT_RADIX, SORT_SAMPLE, SORT_QUICKSORT, SORT_ALGORITHMS };
+static const char *sort_algorithm_names[SORT_ALGORITHMS] = { "cilksort", "radix", "sample", "quicksort" };
+static int sort_algorithm = SORT_CILKSORT;
+
+/* Input distribution, chosen with BOTS_SORT_INPUT */
+enum sort_input { INPUT_PERMUTATION, INPUT_UNIFORM, INPUT_ZIPF, INPUT_DUPS, INPUT_SORTED, INPUT_REVERSE, SORT_INPUTS };
+static const char *sort_input_names[SORT_INPUTS] = { "permutation", "uniform", "zipf", "dups", "sorted", "reverse" };
+static int sort_input = INPUT_PERMUTATION;
+
+/* Sum of a hash of every input key, so the verification can tell none was lost */
+static unsigned long input_checksum;
+
+static leaf_sort_t leaf_sort;
+#if defined(SORT_MERGE_SIMD)
+static merge_t simd_merge;
+#endif
+static const char *leaf_sort_name = "scalar";
+static const char *merge_name =
+#if defined(SORT_MERGE_BRANCHY)
+     "branchy";
+#else
+     "branchless";
+#endif
+
 static unsigned long rand_nxt = 0;
 
 static inline unsigned long my_rand(void)
@@ -192,8 +220,9 @@ void seqquick(ELM *low, ELM *high)
      insertion_sort(low, high);
 }
 
-void seqmerge(ELM *low1, ELM *high1, ELM *low2, ELM *high2,
-	      ELM *lowdest)
+#if defined(SORT_MERGE_BRANCHY)
+void seqmerge_scalar(ELM *low1, ELM *high1, ELM *low2, ELM *high2,
+		     ELM *lowdest)
 {
      ELM a1, a2;
 
@@ -265,6 +294,52 @@ void seqmerge(ELM *low1, ELM *high1, ELM *low2, ELM *high2,
 	  memcpy(lowdest, low1, sizeof(ELM) * (high1 - low1 + 1));
      }
 }
+#else
+void seqmerge_scalar(ELM *low1, ELM *high1, ELM *low2, ELM *high2,
+		     ELM *lowdest)
+{
+     ELM a1, a2;
+     long take1;
+
+     /*
+      * Same merge without the data dependent branch, which is
+      * mispredicted about half of the time on random input: the
+      * element is picked and the pointers are advanced with
+      * conditional moves and arithmetic, so the only branch left
+      * is the (well predicted) loop condition.
+      */
+     while (low1 <= high1 && low2 <= high2) {
+	  a1 = *low1;
+	  a2 = *low2;
+	  take1 = a1 < a2;
+	  *lowdest++ = take1 ? a1 : a2;
+	  low1 += take1;
+	  low2 += 1 - take1;
+     }
+     if (low1 > high1) {
+	  memcpy(lowdest, low2, sizeof(ELM) * (high2 - low2 + 1));
+     } else {
+	  memcpy(lowdest, low1, sizeof(ELM) * (high1 - low1 + 1));
+     }
+}
+#endif
+
+/*
+ * The merge below the parallel merge cutoff. The kernel is chosen when
+ * building (make SORT_MERGE=BRANCHY|BRANCHLESS|SIMD); the SIMD one still
+ * falls back to the scalar merge on CPUs without AVX2.
+ */
+void seqmerge(ELM *low1, ELM *high1, ELM *low2, ELM *high2,
+	      ELM *lowdest)
+{
+#if defined(SORT_MERGE_SIMD)
+     if (simd_merge) {
+	  simd_merge(low1, high1 - low1 + 1, low2, high2 - low2 + 1, lowdest);
+	  return;
+     }
+#endif
+     seqmerge_scalar(low1, high1, low2, high2, lowdest);
+}
 
 #define swap_indices(a, b) \
 { \
@@ -326,7 +401,7 @@ void cilkmerge_par(ELM *low1, ELM *high1, ELM *low2, ELM *high2, ELM *lowdest)
      }
      if (high2 < low2) {
 	  /* smaller range is empty */
-	  memcpy(lowdest, low1, sizeof(ELM) * (high1 - low1));
+	  memcpy(lowdest, low1, sizeof(ELM) * (high1 - low1 + 1));
 	  return;
      }
      if (high2 - low2 < bots_app_cutoff_value ) {
@@ -349,14 +424,14 @@ void cilkmerge_par(ELM *low1, ELM *high1, ELM *low2, ELM *high2, ELM *lowdest)
       * the appropriate location
       */
      *(lowdest + lowsize + 1) = *split1;
-     oneapi::tbb::task_group g;
+     counting_task_group g;
      g.run([=] {cilkmerge_par(low1, split1 - 1, low2, split2, lowdest);});
      g.run([=] {cilkmerge_par(split1 + 1, high1, split2 + 1, high2, lowdest + lowsize + 2);});
      g.wait();
      return;
 }
 
-void cilksort_par(ELM *low, ELM *tmp, long size)
+void cilksort_par(ELM *low, ELM *tmp, long size, bool top_level)
 {
      /*
       * divide the input in four parts of the same size (A, B, C, D)
@@ -369,8 +444,11 @@ void cilksort_par(ELM *low, ELM *tmp, long size)
      ELM *A, *B, *C, *D, *tmpA, *tmpB, *tmpC, *tmpD;
 
      if (size < bots_app_cutoff_value_1 ) {
-	  /* quicksort when less than 1024 elements */
-	  seqquick(low, low + size - 1);
+	  /* quicksort when less than 1024 elements, or a sorting network */
+	  if (leaf_sort)
+	       leaf_sort(low, tmp, size);
+	  else
+	       seqquick(low, low + size - 1);
 	  return;
      }
      A = low;
@@ -382,21 +460,200 @@ void cilksort_par(ELM *low, ELM *tmp, long size)
      D = C + quarter;
      tmpD = tmpC + quarter;
 
-     oneapi::tbb::task_group g;
+     /* with NUMA arenas the quarters are sorted next to their data */
+     numa_task_group g(top_level);
 
-     g.run([=] {cilksort_par(A, tmpA, quarter); });
-     g.run([=] {cilksort_par(B, tmpB, quarter); });
-     g.run([=] {cilksort_par(C, tmpC, quarter); });
-     g.run([=] {cilksort_par(D, tmpD, size - 3 * quarter); });
+     g.run(A, [=] {cilksort_par(A, tmpA, quarter); });
+     g.run(B, [=] {cilksort_par(B, tmpB, quarter); });
+     g.run(C, [=] {cilksort_par(C, tmpC, quarter); });
+     g.run(D, [=] {cilksort_par(D, tmpD, size - 3 * quarter); });
      g.wait();
 
-     g.run([=] {cilkmerge_par(A, A + quarter - 1, B, B + quarter - 1, tmpA); });
-     g.run([=] {cilkmerge_par(C, C + quarter - 1, D, low + size - 1, tmpC); });
+     g.run(tmpA, [=] {cilkmerge_par(A, A + quarter - 1, B, B + quarter - 1, tmpA); });
+     g.run(tmpC, [=] {cilkmerge_par(C, C + quarter - 1, D, low + size - 1, tmpC); });
 
      g.wait();
      cilkmerge_par(tmpA, tmpC - 1, tmpC, tmpA + size - 1, A);
 }
 
+/*
+ * Parallel in-place quicksort, the alternative to cilksort that needs no
+ * tmp array. Its partition is done by blocks:
+ *
+ *   1) every block of the range is partitioned on its own, in parallel,
+ *      leaving it as [keys < pivot | keys >= pivot] (see block_partition);
+ *   2) with S keys < pivot in total, the large keys that ended up in
+ *      [0, S) and the small ones in [S, n) are equally many. The k-th of
+ *      the former is swapped with the k-th of the latter, again in
+ *      parallel over k.
+ *
+ * Both halves are then sorted in parallel.
+ */
+#define PARTITION_MIN_BLOCK (64*1024)
+
+/* Scratch space of the SIMD leaf sort, one cutoff's worth per thread */
+static oneapi::tbb::enumerable_thread_specific<std::vector<ELM>> leaf_scratch;
+
+/*
+ * Sequential partition of [first, last) into [pred true | pred false],
+ * without data dependent branches (Edelkamp and Weiss' BlockQuicksort):
+ * the places of the misplaced keys of a block at each end are gathered
+ * first, and then swapped pairwise.
+ */
+#define PARTITION_BUFFER 64
+
+template <typename Pred>
+static ELM *block_partition(ELM *first, ELM *last, Pred pred)
+{
+     unsigned char left[PARTITION_BUFFER], right[PARTITION_BUFFER];
+     int nleft = 0, nright = 0, sleft = 0, sright = 0, i, n;
+     ELM t;
+
+     while (last - first > 2 * PARTITION_BUFFER) {
+	  if (nleft == 0) {
+	       sleft = 0;
+	       for (i = 0; i < PARTITION_BUFFER; i++) {
+		    left[nleft] = i;
+		    nleft += !pred(first[i]);
+	       }
+	  }
+	  if (nright == 0) {
+	       sright = 0;
+	       for (i = 0; i < PARTITION_BUFFER; i++) {
+		    right[nright] = i;
+		    nright += pred(last[-1 - i]);
+	       }
+	  }
+	  n = std::min(nleft, nright);
+	  for (i = 0; i < n; i++) {
+	       t = first[left[sleft + i]];
+	       first[left[sleft + i]] = last[-1 - right[sright + i]];
+	       last[-1 - right[sright + i]] = t;
+	  }
+	  nleft -= n;
+	  nright -= n;
+	  sleft += n;
+	  sright += n;
+	  if (nleft == 0)
+	       first += PARTITION_BUFFER;
+	  if (nright == 0)
+	       last -= PARTITION_BUFFER;
+     }
+
+     /* at most two blocks are left in the middle */
+     return std::partition(first, last, pred);
+}
+
+/* Misplaced keys, as ranges of low: start of each and their total before it */
+struct misplaced {
+     std::vector<long> begin, offset;
+
+     void add(long b, long e) {
+	  if (b >= e)
+	       return;
+	  if (offset.empty())
+	       offset.push_back(0);
+	  begin.push_back(b);
+	  offset.push_back(offset.back() + e - b);
+     }
+
+     /* range holding the k-th misplaced key */
+     long find(long k) const {
+	  return std::upper_bound(offset.begin(), offset.end(), k) - offset.begin() - 1;
+     }
+};
+
+template <typename Pred>
+static long partition_par(ELM *low, long n, Pred pred)
+{
+     long nblocks = std::min(4L * arena_max_concurrency(), n / PARTITION_MIN_BLOCK);
+     long b, total = 0;
+
+     if (nblocks < 2)
+	  return block_partition(low, low + n, pred) - low;
+
+     std::vector<long> split(nblocks);
+     long *sp = split.data();
+     oneapi::tbb::parallel_for(oneapi::tbb::blocked_range<long>(0, nblocks, 1),
+	  [=](const oneapi::tbb::blocked_range<long> &r) {
+	       ++task_counts.local();
+	       for (long i = r.begin(); i != r.end(); i++)
+		    sp[i] = block_partition(low + n * i / nblocks, low + n * (i + 1) / nblocks, pred) - low;
+	  }, oneapi::tbb::simple_partitioner());
+
+     for (b = 0; b < nblocks; b++)
+	  total += split[b] - n * b / nblocks;
+
+     misplaced large, small;
+     for (b = 0; b < nblocks; b++) {
+	  long begin = n * b / nblocks, end = n * (b + 1) / nblocks;
+	  large.add(split[b], std::min(end, total));
+	  small.add(std::max(begin, total), split[b]);
+     }
+     if (large.begin.empty())
+	  return total;
+
+     const misplaced *l = &large, *s = &small;
+     oneapi::tbb::parallel_for(oneapi::tbb::blocked_range<long>(0, large.offset.back(), PARTITION_MIN_BLOCK),
+	  [=](const oneapi::tbb::blocked_range<long> &r) {
+	       long k = r.begin(), li = l->find(k), si = s->find(k), run;
+
+	       ++task_counts.local();
+	       while (k < (long) r.end()) {
+		    run = std::min(std::min(l->offset[li + 1], s->offset[si + 1]), (long) r.end()) - k;
+		    std::swap_ranges(low + l->begin[li] + k - l->offset[li],
+				     low + l->begin[li] + k - l->offset[li] + run,
+				     low + s->begin[si] + k - s->offset[si]);
+		    k += run;
+		    if (k == l->offset[li + 1])
+			 li++;
+		    if (k == s->offset[si + 1])
+			 si++;
+	       }
+	  });
+
+     return total;
+}
+
+void quicksort_par(ELM *low, long size)
+{
+     ELM pivot;
+     long m, e = size / 8;
+
+     if (size < bots_app_cutoff_value_1) {
+	  if (leaf_sort) {
+	       std::vector<ELM> &scratch = leaf_scratch.local();
+	       if ((long) scratch.size() < size)
+		    scratch.resize(bots_app_cutoff_value_1);
+	       leaf_sort(low, scratch.data(), size);
+	  } else {
+	       seqquick(low, low + size - 1);
+	  }
+	  return;
+     }
+
+     /* median of three medians of three */
+     pivot = med3(med3(low[0], low[e], low[2 * e]),
+		  med3(low[3 * e], low[4 * e], low[5 * e]),
+		  med3(low[6 * e], low[7 * e], low[size - 1]));
+
+     m = partition_par(low, size, [=](const ELM &x) { return x < pivot; });
+     if (m == 0) {
+	  /*
+	   * the pivot is the smallest key: the keys equal to it are put
+	   * first, and are already in place
+	   */
+	  m = partition_par(low, size, [=](const ELM &x) { return x <= pivot; });
+	  quicksort_par(low + m, size - m);
+	  return;
+     }
+
+     counting_task_group g;
+     g.run([=] { quicksort_par(low, m); });
+     quicksort_par(low + m, size - m);
+     g.wait();
+}
+
 void scramble_array( ELM *array )
 {
      unsigned long i;
@@ -409,15 +666,181 @@ void scramble_array( ELM *array )
      }
 }
 
+/* splitmix64: the x-th number of a reproducible pseudo-random sequence */
+static inline unsigned long hash64(unsigned long x)
+{
+     x += 0x9e3779b97f4a7c15UL;
+     x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9UL;
+     x = (x ^ (x >> 27)) * 0x94d049bb133111ebUL;
+     return x ^ (x >> 31);
+}
+
+/*
+ * Zipf distribution of the ranks 1..n, with rank k drawn with probability
+ * proportional to 1/k^ZIPF_EXPONENT. It is sampled by rejection-inversion
+ * (W. Hormann and G. Derflinger, "Rejection-inversion to generate variates
+ * from monotone discrete distributions", 1996), which needs no table and
+ * only a few random numbers per key, so every key can be drawn on its own.
+ */
+#define ZIPF_EXPONENT 1.0
+
+static double zipf_h_x1, zipf_h_n, zipf_s;
+
+static inline double zipf_helper1(double x)
+{
+     return fabs(x) > 1e-8 ? log1p(x) / x : 1 - x * (0.5 - x * (1.0 / 3 - 0.25 * x));
+}
+
+static inline double zipf_helper2(double x)
+{
+     return fabs(x) > 1e-8 ? expm1(x) / x : 1 + x * 0.5 * (1 + x / 3 * (1 + 0.25 * x));
+}
+
+/* integral of the density x^-s, its inverse, and the density itself */
+static inline double zipf_H(double x)
+{
+     double l = log(x);
+     return zipf_helper2((1 - ZIPF_EXPONENT) * l) * l;
+}
+
+static inline double zipf_H_inv(double x)
+{
+     double t = x * (1 - ZIPF_EXPONENT);
+     if (t < -1)
+	  t = -1;
+     return exp(zipf_helper1(t) * x);
+}
+
+static inline double zipf_h(double x)
+{
+     return exp(-ZIPF_EXPONENT * log(x));
+}
+
+static void zipf_init(long n)
+{
+     zipf_h_x1 = zipf_H(1.5) - 1;
+     zipf_h_n = zipf_H(n + 0.5);
+     zipf_s = 2 - zipf_H_inv(zipf_H(2.5) - zipf_h(2));
+}
+
+static long zipf_rank(unsigned long seed, long n)
+{
+     unsigned long j;
+     double u, x;
+     long k;
+
+     for (j = 0; ; j++) {
+	  u = zipf_h_n + (hash64(seed + j) >> 11) * 0x1.0p-53 * (zipf_h_x1 - zipf_h_n);
+	  x = zipf_H_inv(u);
+	  k = (long) (x + 0.5);
+	  if (k < 1)
+	       k = 1;
+	  else if (k > n)
+	       k = n;
+	  if (k - x <= zipf_s || u >= zipf_H(k + 0.5) - zipf_h(k))
+	       return k;
+     }
+}
+
+/* Number of distinct keys of the "dups" input, sqrt(n) */
+static long dups_values;
+
+static KEY input_key(long i)
+{
+     switch (sort_input) {
+     case INPUT_UNIFORM:
+	  return (KEY) hash64(i);
+     case INPUT_ZIPF:
+	  return (KEY) zipf_rank(hash64(i), bots_arg_size);
+     case INPUT_DUPS:
+	  return (KEY) (hash64(i) % dups_values);
+     case INPUT_REVERSE:
+	  return (KEY) (bots_arg_size - 1 - i);
+     default:
+	  /* sorted, and the permutation before it is scrambled */
+	  return (KEY) i;
+     }
+}
+
+/*
+ * The payload of a record is made from its key, so the verification can
+ * tell it travelled with the key.
+ */
+static inline unsigned char payload_byte(unsigned long hash, int j)
+{
+     return (unsigned char) ((hash >> (8 * (j % 8))) + j / 8);
+}
+
+static inline void make_record(KEY &e, KEY k)
+{
+     e = k;
+}
+
+static inline bool record_ok(const KEY &)
+{
+     return true;
+}
+
+template <int Payload>
+static inline void make_record(sort_record<KEY, Payload> &e, KEY k)
+{
+     unsigned long hash = hash64((unsigned long) k);
+     int j;
+
+     e.key = k;
+     for (j = 0; j < Payload; j++)
+	  e.payload[j] = payload_byte(hash, j);
+}
+
+template <int Payload>
+static inline bool record_ok(const sort_record<KEY, Payload> &e)
+{
+     unsigned long hash = hash64((unsigned long) e.key);
+     int j;
+
+     for (j = 0; j < Payload; j++)
+	  if (e.payload[j] != payload_byte(hash, j))
+	       return false;
+     return true;
+}
+
+static void fill_range( void *arg, long begin, long end )
+{
+     ELM *array = (ELM *) arg;
+     long i;
+
+     for (i = begin; i < end; ++i) {
+	  make_record(array[i], input_key(i));
+     }
+}
+
+static void clear_range( void *arg, long begin, long end )
+{
+     memset((ELM *) arg + begin, 0, (end - begin) * sizeof(ELM));
+}
+
 void fill_array( ELM *array )
 {
-     unsigned long i;
+     long i;
 
      my_srand(1);
-     /* first, fill with integers 1..size */
-     for (i = 0; i < bots_arg_size; ++i) {
-	  array[i] = i;
-     }
+     /* first, fill with the keys in order (pages are first touched in parallel) */
+     bots_first_touch(bots_arg_size, sizeof(ELM), arena_max_concurrency(), fill_range, array);
+
+     input_checksum = 0;
+     for (i = 0; i < bots_arg_size; ++i)
+	  input_checksum += hash64((unsigned long) key_of(array[i]));
+}
+
+/* Index of name in names[0..n), -1 if it is not there */
+static int find_name(const char *name, const char **names, int n)
+{
+     int i;
+
+     for (i = 0; i < n; i++)
+	  if (!strcmp(name, names[i]))
+	       return i;
+     return -1;
 }
 
 extern "C" void sort_init ( void )
@@ -455,27 +878,140 @@ extern "C" void sort_init ( void )
         bots_app_cutoff_value_2 = bots_app_cutoff_value_1;
      }
 
+     char *algorithm_a = getenv("BOTS_SORT_ALGORITHM");
+     if (algorithm_a) {
+	  sort_algorithm = find_name(algorithm_a, sort_algorithm_names, SORT_ALGORITHMS);
+	  if (sort_algorithm < 0) {
+	       bots_message("BOTS_SORT_ALGORITHM can only be cilksort, radix, sample or quicksort, using cilksort.\n");
+	       sort_algorithm = SORT_CILKSORT;
+	  }
+     }
+
+     char *input_a = getenv("BOTS_SORT_INPUT");
+     if (input_a) {
+	  sort_input = find_name(input_a, sort_input_names, SORT_INPUTS);
+	  if (sort_input < 0) {
+	       bots_message("BOTS_SORT_INPUT can only be permutation, uniform, zipf, dups, sorted or reverse, using permutation.\n");
+	       sort_input = INPUT_PERMUTATION;
+	  }
+     }
+     zipf_init(bots_arg_size);
+     dups_values = (long) ceil(sqrt((double) bots_arg_size));
+
+     /* the SIMD leaves are picked on CPUs with AVX2 (BOTS_SORT_SIMD=0 keeps
+      * the scalar ones), the SIMD merge is chosen when building */
+     char *simd_a = getenv("BOTS_SORT_SIMD");
+     sortnet_kernels simd;
+     if (sortnet_select(&simd)) {
+	  if (!simd_a || atoi(simd_a) > 0) {
+	       leaf_sort = simd.leaf_sort;
+	       leaf_sort_name = simd.name;
+	  }
+#if defined(SORT_MERGE_SIMD)
+	  simd_merge = simd.merge;
+	  merge_name = simd.name;
+#endif
+     }
+
      array = (ELM *) malloc(bots_arg_size * sizeof(ELM));
-     tmp = (ELM *) malloc(bots_arg_size * sizeof(ELM));
+     /* the in-place quicksort does without tmp */
+     if (sort_algorithm != SORT_QUICKSORT) {
+	  tmp = (ELM *) malloc(bots_arg_size * sizeof(ELM));
+	  bots_first_touch(bots_arg_size, sizeof(ELM), arena_max_concurrency(), clear_range, tmp);
+     }
+}
+
+/* For the parameters string, which is built after sort_init */
+extern "C" const char *sort_algorithm_name ( void )
+{
+     return sort_algorithm_names[sort_algorithm];
+}
+
+extern "C" const char *sort_input_name ( void )
+{
+     return sort_input_names[sort_input];
+}
+
+#define SORT_STR(x) #x
+#define SORT_XSTR(x) SORT_STR(x)
+
+extern "C" const char *sort_key_name ( void )
+{
+     return SORT_XSTR(SORT_KEY);
+}
+
+extern "C" int sort_payload_size ( void )
+{
+     return SORT_PAYLOAD;
+}
+
+extern "C" const char *sort_leaf_name ( void )
+{
+     return leaf_sort_name;
+}
+
+extern "C" const char *sort_merge_name ( void )
+{
+     return merge_name;
+}
+
+/* (Re)generates the input so every repetition sorts the same keys */
+extern "C" void sort_reset ( void )
+{
      fill_array(array);
-     scramble_array(array);
+     if (sort_input == INPUT_PERMUTATION)
+	  scramble_array(array);
 }
 
 extern "C" void sort_par ( void )
 {
-	bots_message("Computing multisort algorithm (n=%d) ", bots_arg_size);
-    arenaptr->execute([=] {
-        cilksort_par(array, tmp, bots_arg_size);
-    });
+     switch (sort_algorithm) {
+     case SORT_RADIX:
+	bots_message("Computing radix sort algorithm (n=%d, %s input) ", bots_arg_size, sort_input_names[sort_input]);
+	arenaptr->execute([=] {
+	     radixsort_par(array, tmp, bots_arg_size);
+	});
+	break;
+     case SORT_SAMPLE:
+	bots_message("Computing sample sort algorithm (n=%d, %s input, %s leaves, %s merges) ", bots_arg_size, sort_input_names[sort_input], leaf_sort_name, merge_name);
+	arenaptr->execute([=] {
+	     samplesort_par(array, tmp, bots_arg_size);
+	});
+	break;
+     case SORT_QUICKSORT:
+	bots_message("Computing quicksort algorithm (n=%d, %s input, %s leaves) ", bots_arg_size, sort_input_names[sort_input], leaf_sort_name);
+	arenaptr->execute([=] {
+	     quicksort_par(array, bots_arg_size);
+	});
+	break;
+     default:
+	bots_message("Computing multisort algorithm (n=%d, %s input, %s leaves, %s merges) ", bots_arg_size, sort_input_names[sort_input], leaf_sort_name, merge_name);
+	arenaptr->execute([=] {
+	     cilksort_par(array, tmp, bots_arg_size, true);
+	});
+     }
 	bots_message(" completed!\n");
 }
 
+/*
+ * The output has to be in order, hold the same keys as the input (by
+ * checksum) and still have every payload next to its key.
+ */
 extern "C" int sort_verify ( void )
 {
-     int i, success = 1;
-     for (i = 0; i < bots_arg_size; ++i)
-	  if (array[i] != i)
+     unsigned long checksum = 0;
+     long i;
+     int success = 1;
+
+     for (i = 0; i < bots_arg_size; ++i) {
+	  if (i > 0 && array[i] < array[i - 1])
+	       success = 0;
+	  if (!record_ok(array[i]))
 	       success = 0;
+	  checksum += hash64((unsigned long) key_of(array[i]));
+     }
+     if (checksum != input_checksum)
+	  success = 0;
 
      return success ? BOTS_RESULT_SUCCESSFUL : BOTS_RESULT_UNSUCCESSFUL;
 }
@@ -1,22 +1,94 @@
 #ifndef _SORT_H
 #define _SORT_H
 
-typedef long ELM;
+#include <stdint.h>
+#include <type_traits>
+
+/*
+ * The records sorted: an integer key and a payload of SORT_PAYLOAD bytes
+ * that has to travel with it. Both are chosen when building, e.g.
+ *
+ *   make SORT_KEY=int64_t SORT_PAYLOAD=24
+ *
+ * (the key type has to be a single word). Records compare by key only.
+ */
+#ifndef SORT_KEY
+#define SORT_KEY long
+#endif
+#ifndef SORT_PAYLOAD
+#define SORT_PAYLOAD 0
+#endif
+
+typedef SORT_KEY KEY;
+static_assert(std::is_integral<KEY>::value, "SORT_KEY has to be an integer type");
+
+template <typename Key, int Payload>
+struct sort_record {
+	Key key;
+	unsigned char payload[Payload];
+};
+
+template <typename Key, int Payload>
+inline bool operator<(const sort_record<Key, Payload> &a, const sort_record<Key, Payload> &b) { return a.key < b.key; }
+template <typename Key, int Payload>
+inline bool operator>(const sort_record<Key, Payload> &a, const sort_record<Key, Payload> &b) { return a.key > b.key; }
+template <typename Key, int Payload>
+inline bool operator<=(const sort_record<Key, Payload> &a, const sort_record<Key, Payload> &b) { return a.key <= b.key; }
+template <typename Key, int Payload>
+inline bool operator>=(const sort_record<Key, Payload> &a, const sort_record<Key, Payload> &b) { return a.key >= b.key; }
+
+/* Without a payload the records are the keys themselves */
+template <typename Key, int Payload>
+struct sort_record_type { typedef sort_record<Key, Payload> type; };
+template <typename Key>
+struct sort_record_type<Key, 0> { typedef Key type; };
+
+typedef sort_record_type<KEY, SORT_PAYLOAD>::type ELM;
+
+inline KEY key_of(KEY k) { return k; }
+template <int Payload>
+inline KEY key_of(const sort_record<KEY, Payload> &r) { return r.key; }
 
 void seqquick(ELM *low, ELM *high); 
 void seqmerge(ELM *low1, ELM *high1, ELM *low2, ELM *high2, ELM *lowdest);
+void seqmerge_scalar(ELM *low1, ELM *high1, ELM *low2, ELM *high2, ELM *lowdest);
 ELM *binsplit(ELM val, ELM *low, ELM *high); 
 void cilkmerge(ELM *low1, ELM *high1, ELM *low2, ELM *high2, ELM *lowdest);
 void cilkmerge_par(ELM *low1, ELM *high1, ELM *low2, ELM *high2, ELM *lowdest);
 void cilksort(ELM *low, ELM *tmp, long size);
-void cilksort_par(ELM *low, ELM *tmp, long size);
+void cilksort_par(ELM *low, ELM *tmp, long size, bool top_level = false);
+void radixsort_par(ELM *low, ELM *tmp, long size);
+void samplesort_par(ELM *low, ELM *tmp, long size);
+void quicksort_par(ELM *low, long size);
 void scramble_array( ELM *array ); 
 void fill_array( ELM *array ); 
 void sort ( void ); 
 
+/* Sorts low[0..size) using tmp[0..size) as scratch space */
+typedef void (*leaf_sort_t)(ELM *low, ELM *tmp, long size);
+/* Merges a[0..na) and b[0..nb) into dest */
+typedef void (*merge_t)(ELM *a, long na, ELM *b, long nb, ELM *dest);
+
+/* SIMD kernels (sortnet.cpp) */
+struct sortnet_kernels {
+	const char *name;
+	leaf_sort_t leaf_sort;
+	merge_t merge;
+};
+
+/* Fills k with the best kernels this CPU supports, false if there are none */
+bool sortnet_select(sortnet_kernels *k);
+
 extern "C" void sort_par (void);
 extern "C" void sort_init (void);
+extern "C" void sort_reset (void);
 extern "C" int sort_verify (void);
+extern "C" const char *sort_algorithm_name (void);
+extern "C" const char *sort_input_name (void);
+extern "C" const char *sort_key_name (void);
+extern "C" int sort_payload_size (void);
+extern "C" const char *sort_leaf_name (void);
+extern "C" const char *sort_merge_name (void);
 extern "C" void par_init();
 
 #endif /* _SORT_H */
@@ -0,0 +1,207 @@
+/**********************************************************************************************/
+/*  This program is part of the Barcelona OpenMP Tasks Suite                                  */
+/*  Copyright (C) 2009 Barcelona Supercomputing Center - Centro Nacional de Supercomputacion  */
+/*  Copyright (C) 2009 Universitat Politecnica de Catalunya                                   */
+/*                                                                                            */
+/*  This program is free software; you can redistribute it and/or modify                      */
+/*  it under the terms of the GNU General Public License as published by                      */
+/*  the Free Software Foundation; either version 2 of the License, or                         */
+/*  (at your option) any later version.                                                       */
+/*                                                                                            */
+/*  This program is distributed in the hope that it will be useful,                           */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of                            */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                             */
+/*  GNU General Public License for more details.                                              */
+/*                                                                                            */
+/*  You should have received a copy of the GNU General Public License                         */
+/*  along with this program; if not, write to the Free Software                               */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA            */
+/**********************************************************************************************/
+
+/*
+ * Sorting network leaf sort and merge on vectors of four 64-bit keys. No
+ * include guard: sortnet.cpp includes this once per instruction set, with
+ *
+ *   SN_NS      the namespace of this copy
+ *   SN_TARGET  the target attribute of its functions
+ *   SN_MINMAX  defined when the ISA has 64-bit min/max (AVX-512VL)
+ */
+
+namespace SN_NS {
+
+/* a <- min(a, b), b <- max(a, b), lane by lane */
+static inline SN_TARGET void minmax(__m256i &a, __m256i &b)
+{
+#ifdef SN_MINMAX
+	__m256i t = _mm256_min_epi64(a, b);
+	b = _mm256_max_epi64(a, b);
+	a = t;
+#else
+	__m256i gt = _mm256_cmpgt_epi64(a, b);
+	__m256i t = _mm256_blendv_epi8(a, b, gt);
+	b = _mm256_blendv_epi8(b, a, gt);
+	a = t;
+#endif
+}
+
+/* sorts the four lanes of a bitonic vector */
+static inline SN_TARGET __m256i clean4(__m256i x)
+{
+	__m256i lo = x, hi = _mm256_permute4x64_epi64(x, 0x4e);
+
+	minmax(lo, hi);
+	x = _mm256_blend_epi32(lo, hi, 0xf0);
+	lo = x;
+	hi = _mm256_permute4x64_epi64(x, 0xb1);
+	minmax(lo, hi);
+	return _mm256_blend_epi32(lo, hi, 0xcc);
+}
+
+/* merges two sorted vectors: a gets the four smallest keys, b the rest */
+static inline SN_TARGET void merge4(__m256i &a, __m256i &b)
+{
+	b = _mm256_permute4x64_epi64(b, 0x1b);
+	minmax(a, b);
+	a = clean4(a);
+	b = clean4(b);
+}
+
+/* sorts 16 keys held in four vectors, in place */
+static inline SN_TARGET void sort16(__m256i &r0, __m256i &r1, __m256i &r2, __m256i &r3)
+{
+	__m256i t0, t1, t2, t3;
+
+	/* sort the columns ... */
+	minmax(r0, r1);
+	minmax(r2, r3);
+	minmax(r0, r2);
+	minmax(r1, r3);
+	minmax(r1, r2);
+
+	/* ... turn them into four sorted rows ... */
+	t0 = _mm256_unpacklo_epi64(r0, r1);
+	t1 = _mm256_unpackhi_epi64(r0, r1);
+	t2 = _mm256_unpacklo_epi64(r2, r3);
+	t3 = _mm256_unpackhi_epi64(r2, r3);
+	r0 = _mm256_permute2x128_si256(t0, t2, 0x20);
+	r1 = _mm256_permute2x128_si256(t1, t3, 0x20);
+	r2 = _mm256_permute2x128_si256(t0, t2, 0x31);
+	r3 = _mm256_permute2x128_si256(t1, t3, 0x31);
+
+	/* ... and merge them: 4+4, 4+4, then 8+8 */
+	merge4(r0, r1);
+	merge4(r2, r3);
+	t0 = _mm256_permute4x64_epi64(r3, 0x1b);
+	t1 = _mm256_permute4x64_epi64(r2, 0x1b);
+	minmax(r0, t0);
+	minmax(r1, t1);
+	minmax(r0, r1);
+	minmax(t0, t1);
+	r2 = clean4(t0);
+	r3 = clean4(t1);
+	r0 = clean4(r0);
+	r1 = clean4(r1);
+}
+
+static SN_TARGET void sort_blocks(ELM *low, ELM *dest, long size)
+{
+	__m256i r0, r1, r2, r3;
+	long i;
+
+	for (i = 0; i + SORTNET_BLOCK <= size; i += SORTNET_BLOCK) {
+		r0 = _mm256_loadu_si256((__m256i *) (low + i));
+		r1 = _mm256_loadu_si256((__m256i *) (low + i + 4));
+		r2 = _mm256_loadu_si256((__m256i *) (low + i + 8));
+		r3 = _mm256_loadu_si256((__m256i *) (low + i + 12));
+		sort16(r0, r1, r2, r3);
+		_mm256_storeu_si256((__m256i *) (dest + i), r0);
+		_mm256_storeu_si256((__m256i *) (dest + i + 4), r1);
+		_mm256_storeu_si256((__m256i *) (dest + i + 8), r2);
+		_mm256_storeu_si256((__m256i *) (dest + i + 12), r3);
+	}
+
+	if (i < size) {
+		/* the last block is padded with keys that sort after all others */
+		ELM buf[SORTNET_BLOCK];
+		long rest = size - i, j;
+
+		for (j = 0; j < SORTNET_BLOCK; j++)
+			buf[j] = j < rest ? low[i + j] : std::numeric_limits<ELM>::max();
+		r0 = _mm256_loadu_si256((__m256i *) buf);
+		r1 = _mm256_loadu_si256((__m256i *) (buf + 4));
+		r2 = _mm256_loadu_si256((__m256i *) (buf + 8));
+		r3 = _mm256_loadu_si256((__m256i *) (buf + 12));
+		sort16(r0, r1, r2, r3);
+		_mm256_storeu_si256((__m256i *) buf, r0);
+		_mm256_storeu_si256((__m256i *) (buf + 4), r1);
+		_mm256_storeu_si256((__m256i *) (buf + 8), r2);
+		_mm256_storeu_si256((__m256i *) (buf + 12), r3);
+		memcpy(dest + i, buf, rest * sizeof(ELM));
+	}
+}
+
+/*
+ * Merges a[0..na) and b[0..nb) into dest, four keys at a time: the
+ * vector of the four largest keys merged so far is merged with the next
+ * four keys of the run with the smaller head.
+ */
+static SN_TARGET void merge_runs(ELM *a, long na, ELM *b, long nb, ELM *dest)
+{
+	__m256i lo, hi;
+	ELM held[4];
+	long ia = 4, ib = 4;
+
+	if (na < 4 || nb < 4) {
+		seqmerge_scalar(a, a + na - 1, b, b + nb - 1, dest);
+		return;
+	}
+
+	lo = _mm256_loadu_si256((__m256i *) a);
+	hi = _mm256_loadu_si256((__m256i *) b);
+	for (;;) {
+		merge4(lo, hi);
+		_mm256_storeu_si256((__m256i *) dest, lo);
+		dest += 4;
+		if (ib == nb || (ia < na && a[ia] <= b[ib])) {
+			if (na - ia < 4)
+				break;
+			lo = _mm256_loadu_si256((__m256i *) (a + ia));
+			ia += 4;
+		} else {
+			if (nb - ib < 4)
+				break;
+			lo = _mm256_loadu_si256((__m256i *) (b + ib));
+			ib += 4;
+		}
+	}
+
+	_mm256_storeu_si256((__m256i *) held, hi);
+	merge_tail(held, a + ia, na - ia, b + ib, nb - ib, dest);
+}
+
+static SN_TARGET void leaf_sort(ELM *low, ELM *tmp, long size)
+{
+	ELM *src, *dest, *t;
+	long width, i, n1, n2;
+	int passes = 0;
+
+	/* the blocks go to whichever buffer makes the last pass end in low */
+	for (width = SORTNET_BLOCK; width < size; width *= 2)
+		passes++;
+	src = passes % 2 ? tmp : low;
+	dest = passes % 2 ? low : tmp;
+	sort_blocks(low, src, size);
+
+	for (width = SORTNET_BLOCK; width < size; width *= 2) {
+		for (i = 0; i < size; i += 2 * width) {
+			n1 = width < size - i ? width : size - i;
+			n2 = width < size - i - n1 ? width : size - i - n1;
+			merge_runs(src + i, n1, src + i + n1, n2, dest + i);
+		}
+		t = src;
+		src = dest;
+		dest = t;
+	}
+}
+
+} /* namespace SN_NS */
@@ -0,0 +1,107 @@
+/**********************************************************************************************/
+/*  This program is part of the Barcelona OpenMP Tasks Suite                                  */
+/*  Copyright (C) 2009 Barcelona Supercomputing Center - Centro Nacional de Supercomputacion  */
+/*  Copyright (C) 2009 Universitat Politecnica de Catalunya                                   */
+/*                                                                                            */
+/*  This program is free software; you can redistribute it and/or modify                      */
+/*  it under the terms of the GNU General Public License as published by                      */
+/*  the Free Software Foundation; either version 2 of the License, or                         */
+/*  (at your option) any later version.                                                       */
+/*                                                                                            */
+/*  This program is distributed in the hope that it will be useful,                           */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of                            */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                             */
+/*  GNU General Public License for more details.                                              */
+/*                                                                                            */
+/*  You should have received a copy of the GNU General Public License                         */
+/*  along with this program; if not, write to the Free Software                               */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA            */
+/**********************************************************************************************/
+
+/*
+ * SIMD leaf sort and merge for cilksort. Blocks of 16 keys are sorted in registers
+ * by a bitonic network, and the sorted blocks are then merged pairwise
+ * with a vector merge network, ping-ponging between the leaf's part of
+ * array and tmp. Every compare-exchange is a vector min/max, so there is
+ * no data dependent branch except one per four merged keys. The merge
+ * is also used by seqmerge when built with SORT_MERGE=SIMD.
+ *
+ * The kernel is compiled for AVX2 and for AVX-512VL (which adds 64-bit
+ * min/max) and picked at run time, so the binary runs on any x86-64. It
+ * is only used for signed 64-bit keys without a payload.
+ */
+
+#include <limits>
+#include <string.h>
+#include "sort.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && SORT_PAYLOAD == 0
+
+#include <immintrin.h>
+
+#define SORTNET_BLOCK 16
+
+/* merges the four keys the vector merge held back with what is left of the runs */
+static void merge_tail(ELM *held, ELM *a, long na, ELM *b, long nb, ELM *dest)
+{
+	int nh = 4;
+
+	while (nh > 0) {
+		if (na > 0 && *a < *held && (nb == 0 || *a <= *b)) {
+			*dest++ = *a++;
+			na--;
+		} else if (nb > 0 && *b < *held) {
+			*dest++ = *b++;
+			nb--;
+		} else {
+			*dest++ = *held++;
+			nh--;
+		}
+	}
+	seqmerge_scalar(a, a + na - 1, b, b + nb - 1, dest);
+}
+
+#define SN_NS sortnet_avx2
+#define SN_TARGET __attribute__((target("avx2")))
+#include "sortnet-kernel.h"
+#undef SN_NS
+#undef SN_TARGET
+
+#define SN_NS sortnet_avx512
+#define SN_TARGET __attribute__((target("avx2,avx512f,avx512vl")))
+#define SN_MINMAX
+#include "sortnet-kernel.h"
+#undef SN_NS
+#undef SN_TARGET
+#undef SN_MINMAX
+
+bool sortnet_select(sortnet_kernels *k)
+{
+	/* the networks compare the records as 64-bit signed integers */
+	if (!std::is_integral<ELM>::value || !std::is_signed<ELM>::value || sizeof(ELM) != 8)
+		return false;
+
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl")) {
+		k->name = "avx512";
+		k->leaf_sort = sortnet_avx512::leaf_sort;
+		k->merge = sortnet_avx512::merge_runs;
+		return true;
+	}
+	if (__builtin_cpu_supports("avx2")) {
+		k->name = "avx2";
+		k->leaf_sort = sortnet_avx2::leaf_sort;
+		k->merge = sortnet_avx2::merge_runs;
+		return true;
+	}
+	return false;
+}
+
+#else
+
+bool sortnet_select(sortnet_kernels *k)
+{
+	return false;
+}
+
+#endif
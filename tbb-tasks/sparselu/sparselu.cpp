@@ -0,0 +1,464 @@
+/**********************************************************************************************/
+/*  This program is part of the Barcelona OpenMP Tasks Suite                                  */
+/*  Copyright (C) 2009 Barcelona Supercomputing Center - Centro Nacional de Supercomputacion  */
+/*  Copyright (C) 2009 Universitat Politecnica de Catalunya                                   */
+/*                                                                                            */
+/*  This program is free software; you can redistribute it and/or modify                      */
+/*  it under the terms of the GNU General Public License as published by                      */
+/*  the Free Software Foundation; either version 2 of the License, or                         */
+/*  (at your option) any later version.                                                       */
+/*                                                                                            */
+/*  This program is distributed in the hope that it will be useful,                           */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of                            */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                             */
+/*  GNU General Public License for more details.                                              */
+/*                                                                                            */
+/*  You should have received a copy of the GNU General Public License                         */
+/*  along with this program; if not, write to the Free Software                               */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA            */
+/**********************************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h> 
+#include <string.h>
+#include <math.h>
+#include <libgen.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <oneapi/tbb.h>
+#include "bots.h"
+#include "sparselu.h"
+#include "arena.h"
+
+/***********************************************************************
+ * checkmat: 
+ **********************************************************************/
+int checkmat (float *M, float *N)
+{
+   int i, j;
+   float r_err;
+
+   for (i = 0; i < bots_arg_size_1; i++)
+   {
+      for (j = 0; j < bots_arg_size_1; j++)
+      {
+         r_err = M[i*bots_arg_size_1+j] - N[i*bots_arg_size_1+j];
+         if ( r_err == 0.0 ) continue;
+
+         if (r_err < 0.0 ) r_err = -r_err;
+
+         if ( M[i*bots_arg_size_1+j] == 0 ) 
+         {
+           bots_message("Checking failure: A[%d][%d]=%f  B[%d][%d]=%f; \n",
+                    i,j, M[i*bots_arg_size_1+j], i,j, N[i*bots_arg_size_1+j]);
+           return FALSE;
+         }  
+         r_err = r_err / M[i*bots_arg_size_1+j];
+         if(r_err > EPSILON)
+         {
+            bots_message("Checking failure: A[%d][%d]=%f  B[%d][%d]=%f; Relative Error=%f\n",
+                    i,j, M[i*bots_arg_size_1+j], i,j, N[i*bots_arg_size_1+j], r_err);
+            return FALSE;
+         }
+      }
+   }
+   return TRUE;
+}
+/***********************************************************************
+ * genmat_range: initializes the blocks [begin, end) of the matrix
+ **********************************************************************/
+typedef struct {
+   float **blocks;
+   long block_elems;
+} genmat_blocks_t;
+
+/* the generator is x' = 3125 x mod 65536, so it can skip ahead */
+static int genmat_skip(int init_val, long steps)
+{
+   long mult = 3125, val = init_val;
+
+   while (steps > 0) {
+      if (steps & 1) val = (mult * val) % 65536;
+      mult = (mult * mult) % 65536;
+      steps >>= 1;
+   }
+   return (int) val;
+}
+
+static void genmat_range(void *arg, long begin, long end)
+{
+   genmat_blocks_t *gen = (genmat_blocks_t *) arg;
+   int init_val;
+   long k, e;
+   float *p;
+
+   /* continue the sequence where the previous blocks left it */
+   init_val = genmat_skip(1325, begin * gen->block_elems);
+   for (k = begin; k < end; k++)
+   {
+      p = gen->blocks[k];
+      for (e = 0; e < gen->block_elems; e++)
+      {
+         init_val = (3125 * init_val) % 65536;
+         (*p) = (float)((init_val - 32768.0) / 16384.0);
+         p++;
+      }
+   }
+}
+/***********************************************************************
+ * genmat: 
+ **********************************************************************/
+void genmat (float *M[])
+{
+   int null_entry, ii, jj;
+   long nblocks = 0;
+   genmat_blocks_t gen;
+
+   gen.block_elems = (long) bots_arg_size_1 * bots_arg_size_1;
+   gen.blocks = (float **) malloc(bots_arg_size*bots_arg_size*sizeof(float *));
+   if (gen.blocks == NULL)
+   {
+      bots_message("Error: Out of memory\n");
+      exit(101);
+   }
+
+   /* generating the structure */
+   for (ii=0; ii < bots_arg_size; ii++)
+   {
+      for (jj=0; jj < bots_arg_size; jj++)
+      {
+         /* computing null entries */
+         null_entry=FALSE;
+         if ((ii<jj) && (ii%3 !=0)) null_entry = TRUE;
+         if ((ii>jj) && (jj%3 !=0)) null_entry = TRUE;
+	 if (ii%2==1) null_entry = TRUE;
+	 if (jj%2==1) null_entry = TRUE;
+	 if (ii==jj) null_entry = FALSE;
+	 if (ii==jj-1) null_entry = FALSE;
+         if (ii-1 == jj) null_entry = FALSE; 
+         /* allocating matrix */
+         if (null_entry == FALSE){
+            M[ii*bots_arg_size+jj] = (float *) malloc(bots_arg_size_1*bots_arg_size_1*sizeof(float));
+	    if (M[ii*bots_arg_size+jj] == NULL)
+            {
+               bots_message("Error: Out of memory\n");
+               exit(101);
+            }
+            gen.blocks[nblocks++] = M[ii*bots_arg_size+jj];
+         }
+         else
+         {
+            M[ii*bots_arg_size+jj] = NULL;
+         }
+      }
+   }
+   /* initializing the blocks in parallel, which also places their pages */
+   bots_first_touch(nblocks, gen.block_elems * sizeof(float), arena_max_concurrency(), genmat_range, &gen);
+   free(gen.blocks);
+}
+/***********************************************************************
+ * print_structure: 
+ **********************************************************************/
+void print_structure(char *name, float *M[])
+{
+   int ii, jj;
+   bots_message("Structure for matrix %s @ 0x%p\n",name, M);
+   for (ii = 0; ii < bots_arg_size; ii++) {
+     for (jj = 0; jj < bots_arg_size; jj++) {
+        if (M[ii*bots_arg_size+jj]!=NULL) {bots_message("x");}
+        else bots_message(" ");
+     }
+     bots_message("\n");
+   }
+   bots_message("\n");
+}
+/***********************************************************************
+ * allocate_clean_block: 
+ **********************************************************************/
+float * allocate_clean_block()
+{
+  int i,j;
+  float *p, *q;
+
+  p = (float *) malloc(bots_arg_size_1*bots_arg_size_1*sizeof(float));
+  q=p;
+  if (p!=NULL){
+     for (i = 0; i < bots_arg_size_1; i++) 
+        for (j = 0; j < bots_arg_size_1; j++){(*p)=0.0; p++;}
+	
+  }
+  else
+  {
+      bots_message("Error: Out of memory\n");
+      exit (101);
+  }
+  return (q);
+}
+
+/***********************************************************************
+ * lu0: 
+ **********************************************************************/
+void lu0(float *diag)
+{
+   int i, j, k;
+
+   for (k=0; k<bots_arg_size_1; k++)
+      for (i=k+1; i<bots_arg_size_1; i++)
+      {
+         diag[i*bots_arg_size_1+k] = diag[i*bots_arg_size_1+k] / diag[k*bots_arg_size_1+k];
+         for (j=k+1; j<bots_arg_size_1; j++)
+            diag[i*bots_arg_size_1+j] = diag[i*bots_arg_size_1+j] - diag[i*bots_arg_size_1+k] * diag[k*bots_arg_size_1+j];
+      }
+}
+
+/***********************************************************************
+ * bdiv: 
+ **********************************************************************/
+void bdiv(float *diag, float *row)
+{
+   int i, j, k;
+   for (i=0; i<bots_arg_size_1; i++)
+      for (k=0; k<bots_arg_size_1; k++)
+      {
+         row[i*bots_arg_size_1+k] = row[i*bots_arg_size_1+k] / diag[k*bots_arg_size_1+k];
+         for (j=k+1; j<bots_arg_size_1; j++)
+            row[i*bots_arg_size_1+j] = row[i*bots_arg_size_1+j] - row[i*bots_arg_size_1+k]*diag[k*bots_arg_size_1+j];
+      }
+}
+/***********************************************************************
+ * bmod: 
+ **********************************************************************/
+void bmod(float *row, float *col, float *inner)
+{
+   int i, j, k;
+   for (i=0; i<bots_arg_size_1; i++)
+      for (j=0; j<bots_arg_size_1; j++)
+         for (k=0; k<bots_arg_size_1; k++)
+            inner[i*bots_arg_size_1+j] = inner[i*bots_arg_size_1+j] - row[i*bots_arg_size_1+k]*col[k*bots_arg_size_1+j];
+}
+/***********************************************************************
+ * fwd: 
+ **********************************************************************/
+void fwd(float *diag, float *col)
+{
+   int i, j, k;
+   for (j=0; j<bots_arg_size_1; j++)
+      for (k=0; k<bots_arg_size_1; k++) 
+         for (i=k+1; i<bots_arg_size_1; i++)
+            col[i*bots_arg_size_1+j] = col[i*bots_arg_size_1+j] - diag[i*bots_arg_size_1+k]*col[k*bots_arg_size_1+j];
+}
+
+
+/* frees a matrix of sparselu_init, with the blocks filled in by the factorization */
+static void free_matrix(float **M)
+{
+   int ii;
+
+   for (ii = 0; ii < bots_arg_size*bots_arg_size; ii++)
+      free(M[ii]);
+   free(M);
+}
+
+void sparselu_init (float ***pBENCH, char *pass)
+{
+   /* a repetition replaces the matrix of the one before */
+   if (*pBENCH != NULL) free_matrix(*pBENCH);
+   *pBENCH = (float **) malloc(bots_arg_size*bots_arg_size*sizeof(float *));
+   genmat(*pBENCH);
+   print_structure(pass, *pBENCH);
+}
+
+/***********************************************************************
+ * Dependency-driven factorization: instead of two taskwaits per kk step,
+ * every block operation waits only for the operations that produce its
+ * blocks, so lu0 of step kk+1 can start as soon as its diagonal block has
+ * been updated while the rest of step kk is still running (lookahead).
+ **********************************************************************/
+enum { OP_LU0, OP_FWD, OP_BDIV, OP_BMOD };
+
+typedef struct {
+   int kind, ii, jj, kk;
+} lu_op_t;
+
+struct lu_graph {
+   std::vector<lu_op_t> ops;
+   std::vector<std::vector<int>> succ;
+   std::unique_ptr<std::atomic<int>[]> pending;   /* predecessors left */
+   std::vector<int> roots;                        /* ops without predecessors */
+};
+
+/***********************************************************************
+ * sparselu_graph: symbolic factorization, including the fill-in, where
+ * each operation depends on the last writer of every block it uses
+ **********************************************************************/
+static void sparselu_graph(float **BENCH, lu_graph &g)
+{
+   int n = bots_arg_size, ii, jj, kk;
+   std::vector<int> last(n*n, -1), npred;
+   std::vector<char> nz(n*n);
+
+   for (ii = 0; ii < n*n; ii++) nz[ii] = BENCH[ii] != NULL;
+
+   auto add = [&](int kind, int ii, int jj, int kk, std::initializer_list<int> deps) {
+      int id = g.ops.size();
+      g.ops.push_back({kind, ii, jj, kk});
+      g.succ.emplace_back();
+      npred.push_back(0);
+      for (int d : deps)
+         if (d >= 0) { g.succ[d].push_back(id); npred[id]++; }
+      last[ii*n+jj] = id;
+      return id;
+   };
+
+   for (kk=0; kk<n; kk++)
+   {
+      int diag = add(OP_LU0, kk, kk, kk, {last[kk*n+kk]});
+      for (jj=kk+1; jj<n; jj++)
+         if (nz[kk*n+jj])
+            add(OP_FWD, kk, jj, kk, {diag, last[kk*n+jj]});
+      for (ii=kk+1; ii<n; ii++)
+         if (nz[ii*n+kk])
+            add(OP_BDIV, ii, kk, kk, {diag, last[ii*n+kk]});
+      for (ii=kk+1; ii<n; ii++)
+         if (nz[ii*n+kk])
+            for (jj=kk+1; jj<n; jj++)
+               if (nz[kk*n+jj])
+               {
+                  add(OP_BMOD, ii, jj, kk, {last[ii*n+kk], last[kk*n+jj], last[ii*n+jj]});
+                  nz[ii*n+jj] = TRUE;
+               }
+   }
+
+   g.pending.reset(new std::atomic<int>[npred.size()]);
+   for (size_t i = 0; i < npred.size(); i++)
+   {
+      g.pending[i].store(npred[i], std::memory_order_relaxed);
+      if (npred[i] == 0) g.roots.push_back(i);
+   }
+}
+
+static void sparselu_op(float **BENCH, const lu_op_t &op)
+{
+   int n = bots_arg_size;
+
+   switch (op.kind)
+   {
+      case OP_LU0:
+         lu0(BENCH[op.kk*n+op.kk]);
+         break;
+      case OP_FWD:
+         fwd(BENCH[op.kk*n+op.kk], BENCH[op.kk*n+op.jj]);
+         break;
+      case OP_BDIV:
+         bdiv(BENCH[op.kk*n+op.kk], BENCH[op.ii*n+op.kk]);
+         break;
+      case OP_BMOD:
+         /* the updates of a block are chained, so only the first allocates */
+         if (BENCH[op.ii*n+op.jj]==NULL) BENCH[op.ii*n+op.jj] = allocate_clean_block();
+         bmod(BENCH[op.ii*n+op.kk], BENCH[op.kk*n+op.jj], BENCH[op.ii*n+op.jj]);
+         break;
+   }
+}
+
+/* Runs an operation, spawns its successors that became ready and keeps
+ * the first of them for itself */
+static void sparselu_task(float **BENCH, lu_graph &g, counting_task_group &tg, int id)
+{
+   while (id >= 0)
+   {
+      int next = -1;
+
+      sparselu_op(BENCH, g.ops[id]);
+      for (int s : g.succ[id])
+         if (g.pending[s].fetch_sub(1, std::memory_order_acq_rel) == 1)
+         {
+            if (next < 0) next = s;
+            else tg.run([=, &g, &tg] { sparselu_task(BENCH, g, tg, s); });
+         }
+      id = next;
+   }
+}
+
+void sparselu_par_call(float **BENCH)
+{
+   lu_graph g;
+
+   bots_message("Computing SparseLU Factorization (%dx%d matrix with %dx%d blocks) ",
+           bots_arg_size,bots_arg_size,bots_arg_size_1,bots_arg_size_1);
+
+   sparselu_graph(BENCH, g);
+   arenaptr->execute([&] {
+      counting_task_group tg;
+
+      /* not g.pending: the first tasks already make other ops ready */
+      for (int i : g.roots)
+         tg.run([&, i] { sparselu_task(BENCH, g, tg, i); });
+      tg.wait();
+   });
+   bots_message(" completed!\n");
+}
+
+void sparselu_seq_call(float **BENCH)
+{
+   int ii, jj, kk;
+
+   for (kk=0; kk<bots_arg_size; kk++)
+   {
+      lu0(BENCH[kk*bots_arg_size+kk]);
+      for (jj=kk+1; jj<bots_arg_size; jj++)
+         if (BENCH[kk*bots_arg_size+jj] != NULL)
+         {
+            fwd(BENCH[kk*bots_arg_size+kk], BENCH[kk*bots_arg_size+jj]);
+         }
+      for (ii=kk+1; ii<bots_arg_size; ii++)
+         if (BENCH[ii*bots_arg_size+kk] != NULL)
+         {
+            bdiv (BENCH[kk*bots_arg_size+kk], BENCH[ii*bots_arg_size+kk]);
+         }
+      for (ii=kk+1; ii<bots_arg_size; ii++)
+         if (BENCH[ii*bots_arg_size+kk] != NULL)
+            for (jj=kk+1; jj<bots_arg_size; jj++)
+               if (BENCH[kk*bots_arg_size+jj] != NULL)
+               {
+                     if (BENCH[ii*bots_arg_size+jj]==NULL) BENCH[ii*bots_arg_size+jj] = allocate_clean_block();
+                     bmod(BENCH[ii*bots_arg_size+kk], BENCH[kk*bots_arg_size+jj], BENCH[ii*bots_arg_size+jj]);
+               }
+
+   }
+}
+
+void init_par()
+{
+   init_arenaptr();
+}
+
+void fini_par()
+{
+   fini_arenaptr();
+}
+
+void sparselu_fini (float **BENCH, char *pass)
+{
+   print_structure(pass, BENCH);
+}
+
+int sparselu_check(float **SEQ, float **BENCH)
+{
+   int ii,jj,ok=1;
+
+   for (ii=0; ((ii<bots_arg_size) && ok); ii++)
+   {
+      for (jj=0; ((jj<bots_arg_size) && ok); jj++)
+      {
+         if ((SEQ[ii*bots_arg_size+jj] == NULL) && (BENCH[ii*bots_arg_size+jj] != NULL)) ok = FALSE;
+         if ((SEQ[ii*bots_arg_size+jj] != NULL) && (BENCH[ii*bots_arg_size+jj] == NULL)) ok = FALSE;
+         if ((SEQ[ii*bots_arg_size+jj] != NULL) && (BENCH[ii*bots_arg_size+jj] != NULL))
+            ok = checkmat(SEQ[ii*bots_arg_size+jj], BENCH[ii*bots_arg_size+jj]);
+      }
+   }
+   if (ok) return BOTS_RESULT_SUCCESSFUL;
+   else return BOTS_RESULT_UNSUCCESSFUL;
+}
+
@@ -46,6 +46,7 @@
 typedef double REAL;
 typedef unsigned long PTR;
 void init_matrix(int n, REAL *A, int an);
+REAL *alloc_matrix(int n);
 void strassen_main_par(REAL *A, REAL *B, REAL *C, int n);
 void strassen_main_seq(REAL *A, REAL *B, REAL *C, int n);
 int compare_matrix(int n, REAL *A, int an, REAL *B, int bn);
@@ -58,10 +59,10 @@ void fini_par();
         bots_message("Error: matrix size (%d) must be a power of 2 and a multiple of %d\n", bots_arg_size, 16);\
         exit (1);\
     }\
-    A = (double *) malloc (bots_arg_size * bots_arg_size * sizeof(double));\
-    B = (double *) malloc (bots_arg_size * bots_arg_size * sizeof(double));\
-    C = (double *) malloc (bots_arg_size * bots_arg_size * sizeof(double));\
-    D = (double *) malloc (bots_arg_size * bots_arg_size * sizeof(double));\
+    A = alloc_matrix(bots_arg_size);\
+    B = alloc_matrix(bots_arg_size);\
+    C = alloc_matrix(bots_arg_size);\
+    D = alloc_matrix(bots_arg_size);\
     init_matrix(bots_arg_size,A,bots_arg_size);\
     init_matrix(bots_arg_size,B,bots_arg_size);
 
@@ -38,6 +38,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "bots.h"
 #include "strassen.h"
 #include "arena.h"
@@ -693,39 +694,40 @@ OptimizedStrassenMultiply_par(REAL *C, REAL *A, REAL *B, unsigned MatrixSize,
 
 	if (Depth < bots_cutoff_value)
 	{
-		oneapi::tbb::task_group g;
+		/* with NUMA arenas the products of the top level run next to their output */
+		numa_task_group g(Depth == 1);
 		/* M2 = A11 x B11 */
-		g.run([=] {
+		g.run(M2, [=] {
 		OptimizedStrassenMultiply_par(M2, A11, B11, QuadrantSize, QuadrantSize, RowWidthA, RowWidthB, Depth+1);
 		});
 
 		/* M5 = S1 * S5 */
-		g.run([=] {
+		g.run(M5, [=] {
 		OptimizedStrassenMultiply_par(M5, S1, S5, QuadrantSize, QuadrantSize, QuadrantSize, QuadrantSize, Depth+1);
 		});
 
 		/* Step 1 of T1 = S2 x S6 + M2 */
-		g.run([=] {
+		g.run(T1sMULT, [=] {
 		OptimizedStrassenMultiply_par(T1sMULT, S2, S6,  QuadrantSize, QuadrantSize, QuadrantSize, QuadrantSize, Depth+1);
 		});
 
 		/* Step 1 of T2 = T1 + S3 x S7 */
-		g.run([=] {
+		g.run(C22, [=] {
 		OptimizedStrassenMultiply_par(C22, S3, S7, QuadrantSize, RowWidthC /*FIXME*/, QuadrantSize, QuadrantSize, Depth+1);
 		});
 
 		/* Step 1 of C11 = M2 + A12 * B21 */
-		g.run([=] {
+		g.run(C11, [=] {
 		OptimizedStrassenMultiply_par(C11, A12, B21, QuadrantSize, RowWidthC, RowWidthA, RowWidthB, Depth+1);
 		});
 
 		/* Step 1 of C12 = S4 x B22 + T1 + M5 */
-		g.run([=] {
+		g.run(C12, [=] {
 		OptimizedStrassenMultiply_par(C12, S4, B22, QuadrantSize, RowWidthC, QuadrantSize, RowWidthB, Depth+1);
 		});
 
 		/* Step 1 of C21 = T2 - A22 * S8 */
-		g.run([=] {
+		g.run(C21, [=] {
 		OptimizedStrassenMultiply_par(C21, A22, S8, QuadrantSize, RowWidthC, RowWidthA, QuadrantSize, Depth+1);
 		});
 
@@ -931,40 +933,41 @@ OptimizedStrassenMultiply_par(REAL *C, REAL *A, REAL *B, unsigned MatrixSize,
 		MatrixOffsetB += RowIncrementB;
 	} /* end column loop */
 
-	oneapi::tbb::task_group g;
+	/* with NUMA arenas the products of the top level run next to their output */
+	numa_task_group g(Depth == 1);
 
 	/* M2 = A11 x B11 */
-	g.run([=] {
+	g.run(M2, [=] {
 	OptimizedStrassenMultiply_par(M2, A11, B11, QuadrantSize, QuadrantSize, RowWidthA, RowWidthB, Depth+1);
 	});
 
 	/* M5 = S1 * S5 */
-	g.run([=] {
+	g.run(M5, [=] {
 	OptimizedStrassenMultiply_par(M5, S1, S5, QuadrantSize, QuadrantSize, QuadrantSize, QuadrantSize, Depth+1);
 	});
 
 	/* Step 1 of T1 = S2 x S6 + M2 */
-	g.run([=] {
+	g.run(T1sMULT, [=] {
 	OptimizedStrassenMultiply_par(T1sMULT, S2, S6,  QuadrantSize, QuadrantSize, QuadrantSize, QuadrantSize, Depth+1);
 	});
 
 	/* Step 1 of T2 = T1 + S3 x S7 */
-	g.run([=] {
+	g.run(C22, [=] {
 	OptimizedStrassenMultiply_par(C22, S3, S7, QuadrantSize, RowWidthC /*FIXME*/, QuadrantSize, QuadrantSize, Depth+1);
 	});
 
 	/* Step 1 of C11 = M2 + A12 * B21 */
-	g.run([=] {
+	g.run(C11, [=] {
 	OptimizedStrassenMultiply_par(C11, A12, B21, QuadrantSize, RowWidthC, RowWidthA, RowWidthB, Depth+1);
 	});
 
 	/* Step 1 of C12 = S4 x B22 + T1 + M5 */
-	g.run([=] {
+	g.run(C12, [=] {
 	OptimizedStrassenMultiply_par(C12, S4, B22, QuadrantSize, RowWidthC, QuadrantSize, RowWidthB, Depth+1);
 	});
 
 	/* Step 1 of C21 = T2 - A22 * S8 */
-	g.run([=] {
+	g.run(C21, [=] {
 	OptimizedStrassenMultiply_par(C21, A22, S8, QuadrantSize, RowWidthC, RowWidthA, QuadrantSize, Depth+1);
 	});
 
@@ -1040,6 +1043,7 @@ init_matrix(int n, REAL *A, int an)
 {
 	int i, j;
 
+	/* rand() is sequential, the pages were placed by alloc_matrix */
 	for (i = 0; i < n; ++i)
 		for (j = 0; j < n; ++j) 
 			ELEM(A, an, i, j) = ((double) rand()) / (double) RAND_MAX; 
@@ -1072,13 +1076,23 @@ compare_matrix(int n, REAL *A, int an, REAL *B, int bn)
 	return BOTS_RESULT_SUCCESSFUL;
 }
 	       
+static void
+clear_matrix_range(void *arg, long begin, long end)
+{
+	memset((REAL *) arg + begin, 0, (end - begin) * sizeof(REAL));
+}
+
 /*
  * Allocate a matrix of side n (therefore n^2 elements)
  */
-REAL *
-alloc_matrix(int n) 
+extern "C" REAL *
+alloc_matrix(int n)
 {
-	return (REAL *)malloc(n * n * sizeof(REAL));
+	REAL *A = (REAL *)malloc(n * n * sizeof(REAL));
+
+	/* place the pages next to the threads that will use them */
+	bots_first_touch((long) n * n, sizeof(REAL), arena_max_concurrency(), clear_matrix_range, A);
+	return A;
 }
 
 extern "C" void
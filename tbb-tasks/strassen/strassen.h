@@ -66,6 +66,6 @@ void OptimizedStrassenMultiply_par(REAL *C, REAL *A, REAL *B, unsigned MatrixSiz
      unsigned RowWidthC, unsigned RowWidthA, unsigned RowWidthB, int Depth);
 void OptimizedStrassenMultiply_seq(REAL *C, REAL *A, REAL *B, unsigned MatrixSize,
      unsigned RowWidthC, unsigned RowWidthA, unsigned RowWidthB, int Depth);
-REAL *alloc_matrix(int n);
+extern "C" REAL *alloc_matrix(int n);
 #endif
 
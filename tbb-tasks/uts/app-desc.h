@@ -0,0 +1,47 @@
+/**********************************************************************************************/
+/*  This program is part of the Barcelona OpenMP Tasks Suite                                  */
+/*  Copyright (C) 2009 Barcelona Supercomputing Center - Centro Nacional de Supercomputacion  */
+/*  Copyright (C) 2009 Universitat Politecnica de Catalunya                                   */
+/*                                                                                            */
+/*  This program is free software; you can redistribute it and/or modify                      */
+/*  it under the terms of the GNU General Public License as published by                      */
+/*  the Free Software Foundation; either version 2 of the License, or                         */
+/*  (at your option) any later version.                                                       */
+/*                                                                                            */
+/*  This program is distributed in the hope that it will be useful,                           */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of                            */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                             */
+/*  GNU General Public License for more details.                                              */
+/*                                                                                            */
+/*  You should have received a copy of the GNU General Public License                         */
+/*  along with this program; if not, write to the Free Software                               */
+/*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA            */
+/**********************************************************************************************/
+#include "tbb-tasks-app.h"
+#include "uts.h"
+
+#define BOTS_APP_NAME "Unbalance Tree Search"
+#define BOTS_APP_PARAMETERS_DESC "%s"
+#define BOTS_APP_PARAMETERS_LIST ,bots_arg_file
+
+#define BOTS_APP_USES_ARG_FILE
+#define BOTS_APP_DEF_ARG_FILE "Input filename"
+#define BOTS_APP_DESC_ARG_FILE "UTS input file (mandatory)"
+
+#define BOTS_APP_INIT \
+  Node root; \
+  uts_read_file(bots_arg_file);
+
+#define BOTS_APP_USES_ARG_CUTOFF
+#define BOTS_APP_DEF_ARG_CUTOFF 20
+#define BOTS_APP_DESC_ARG_CUTOFF "Nodes per stolen chunk"
+
+#define KERNEL_INIT uts_init(); uts_initRoot(&root);
+
+#define KERNEL_CALL parallel_uts(&root);
+
+#define KERNEL_FINI uts_fini(); uts_show_stats();
+
+#define KERNEL_CHECK uts_check_result();
+
+